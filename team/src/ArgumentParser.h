@@ -38,6 +38,15 @@ class ArgumentParser {
   std::string teamParamsFile;   // Empty = use team default
   std::string testMovesFile;    // Test moves file for scripted teams (e.g., testteam)
   std::optional<std::string> shipArtSelection;  // Custom ship art request (SNAME or FNAME:SNAME)
+  bool tcpOnly = false;  // No shared-memory link to a server on this host
+
+  // Server options
+  std::optional<uint32_t> gameSeedOverride;  // Deterministic world/physics RNG seed
+  bool keyframesOnly = false;  // Send full world images only, no deltas
+  bool observerLockstep = false;  // Pace the game by observer acks
+  bool spectators = false;  // Relay mode: observers may join at any time
+  bool fullPrecision = false;  // Exact doubles on the wire
+  std::string recordFile;  // Match log to record the game to; empty = none
 
   // Observer options
   bool verbose = false;          // Verbose output for observer
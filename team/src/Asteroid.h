@@ -34,11 +34,16 @@ class CAsteroid : public CThing {
   unsigned GetSerialSize() const;
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
+  void CopyState(const CThing& OthThing);
 
  protected:
   AsteroidKind material;
   CThing* pThEat;  // Ptr to ship which captures asteroid, initially NULL
 
+  typedef serial::Extend<CThing::SerialFields,
+                         serial::Field<&CAsteroid::material>>
+      SerialFields;  // Wire layout
+
   virtual CAsteroid* MakeChildAsteroid(double dm = 40.0);
   virtual void HandleCollision(CThing* pOthThing, CWorld* pWorld = NULL);
 
@@ -11,6 +11,7 @@
 class CWorld;
 class CTeam;
 class CClientNet;
+class SnapshotDecoder;
 
 class CClient {
  public:
@@ -36,7 +37,11 @@ class CClient {
   unsigned int numTeams;
   unsigned int umyIndex;  // For client teams; doesn't do much for observer
 
+  // Decodes a world frame and unpacks it into pmyWorld
+  unsigned int UnpackWorldFrame(const char *frame, unsigned int len);
+
   CClientNet *pmyNet;
+  SnapshotDecoder *pmySnap;  // Rebuilds world images from keyframes/deltas
   CWorld *pmyWorld;
   CTeam **aTms;
 };
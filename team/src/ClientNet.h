@@ -11,8 +11,13 @@
 
 class CClientNet : public CNetwork {
  private:
+  bool ConnectLocal(int port);  // Unix socket and shared-memory link
+
  public:
-  CClientNet(char* hostname, int port, int maxqueuelen = 204800);
+  // A client that may share memory with a server on this host tries that
+  // first and falls back to TCP.
+  CClientNet(char* hostname, int port, int maxqueuelen = 204800,
+             bool mayshare = false);
   ~CClientNet();
 };
 
@@ -0,0 +1,39 @@
+/* CollisionGrid.h
+ * Uniform toroidal grid used as the collision broadphase
+ * For use with MechMania IV
+ *
+ * Items (the team objects) are binned into every cell their reach disc can
+ * touch, wrapping across the world edges. Querying a point returns the
+ * items that might be within reach of it, in insertion order, so callers
+ * that insert in list order see candidates in that same order.
+ */
+
+#ifndef _COLLISION_GRID_H_MM4
+#define _COLLISION_GRID_H_MM4
+
+#include <vector>
+
+#include "Coord.h"
+
+class CollisionGrid {
+ public:
+  // 16 x 16 cells of 64 x 64 units over the 1024 x 1024 world
+  static const int kCellsPerSide = 16;
+
+  void Clear();
+
+  // Register item at pos, touching everything within reach of it.
+  void Insert(unsigned int item, const CCoord& pos, double reach);
+
+  // Items whose reach may include pos (a superset of the true matches).
+  const std::vector<unsigned int>& Query(const CCoord& pos) const;
+
+ private:
+  static int CellOf(double coord, double min, double cell_size);
+
+  // Cell vectors keep their capacity between ticks, so steady-state
+  // Clear/Insert does not allocate.
+  std::vector<unsigned int> cells_[kCellsPerSide * kCellsPerSide];
+};
+
+#endif  // _COLLISION_GRID_H_MM4
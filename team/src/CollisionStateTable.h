@@ -0,0 +1,54 @@
+/* CollisionStateTable.h
+ * Dense per-tick store of CollisionState snapshots
+ * For use with MechMania IV
+ *
+ * Entries live in a flat array addressed by CThing::GetWorldIndex(). The
+ * array is kept between ticks and Reset() only bumps an epoch stamp, so a
+ * physics sub-tick neither allocates nor clears. The stored thing pointer
+ * is compared on every lookup, so objects that are not (or no longer) in
+ * the world simply read as absent.
+ *
+ * A table can be layered over a base table: lookups fall through to the
+ * base, and the first FindMutable() of an entry copies it into the overlay
+ * (copy-on-write). This is how the pipeline keeps the immutable tick-start
+ * snapshots and the evolving "current" states without a full copy.
+ */
+
+#ifndef _COLLISION_STATE_TABLE_H_MM4
+#define _COLLISION_STATE_TABLE_H_MM4
+
+#include <vector>
+
+#include "CollisionTypes.h"
+
+class CollisionStateTable {
+ public:
+  CollisionStateTable();
+
+  // Drop every entry. capacity is the number of world index slots needed;
+  // base (optional) is the table this one overlays.
+  void Reset(unsigned int capacity, const CollisionStateTable* base = nullptr);
+
+  // Current state of thing, or nullptr if neither this table nor its base
+  // has one.
+  const CollisionState* Find(const CThing* thing) const;
+
+  // Writable state of thing, copied up from the base on first use. nullptr
+  // if no state exists.
+  CollisionState* FindMutable(const CThing* thing);
+
+  // Add a state for thing unless one is already present here (like
+  // std::map::emplace). Returns the stored entry, or nullptr if thing has
+  // no world slot.
+  CollisionState* Insert(const CThing* thing, const CollisionState& state);
+
+ private:
+  CollisionState* Own(const CThing* thing);
+
+  const CollisionStateTable* base_;
+  std::vector<CollisionState> states_;
+  std::vector<unsigned int> stamps_;  // Entry is live when stamp == epoch_
+  unsigned int epoch_;
+};
+
+#endif  // _COLLISION_STATE_TABLE_H_MM4
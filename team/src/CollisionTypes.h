@@ -8,6 +8,8 @@
 #ifndef _COLLISION_TYPES_H_MM4_DETERMINISTIC
 #define _COLLISION_TYPES_H_MM4_DETERMINISTIC
 
+#include <vector>
+
 #include "Coord.h"
 #include "Traj.h"
 #include "GameConstants.h"
@@ -88,22 +90,47 @@ enum class CollisionCommandType {
   kAnnounceMessage    // Add message to world announcer
 };
 
+// Announcer text emitted during a tick is interned into a CollisionMessageArena
+// and commands carry only a handle to it. This keeps every command small and
+// trivially copyable; the arena owns the text until the world clears it at the
+// start of the next collision or laser pass.
+typedef unsigned int CollisionMessageHandle;
+const CollisionMessageHandle kNoCollisionMessage = (CollisionMessageHandle)-1;
+
+class CollisionMessageArena {
+ public:
+  void Clear() { text_.clear(); }
+
+  // Copies msg (including terminator) into the arena. Returns
+  // kNoCollisionMessage for NULL or empty strings.
+  CollisionMessageHandle Intern(const char* msg);
+
+  // Returns the interned text, or NULL for kNoCollisionMessage or a handle
+  // from before the last Clear(). Valid until the next Intern() or Clear().
+  const char* Get(CollisionMessageHandle handle) const;
+
+ private:
+  std::vector<char> text_;
+};
+
 struct CollisionCommand {
   CollisionCommandType type;
+  bool bool_flag;             // For kSetDocked
   CThing* target;             // Which object this command applies to
 
-  // Type-specific data (only one field used based on type)
-  // We store all possible data types as separate fields to avoid union issues
-  CTraj velocity;             // For kSetVelocity
-  CCoord position;            // For kSetPosition
-  double scalar;              // For kAdjustShield/Cargo/Fuel (delta value)
-  bool bool_flag;             // For kSetDocked
-  CThing* thing_ptr;          // For kRecordEatenBy (eater pointer)
+  // Type-specific payload; which member is live depends on type. kSetDocked
+  // uses bool_flag plus scalar (docking station's team world index).
+  union {
+    double vec[2];                   // kSetVelocity (rho, theta) / kSetPosition (x, y)
+    double scalar;                   // kAdjustShield/Cargo/Fuel delta, kSetDocked
+    CThing* thing_ptr;               // kRecordEatenBy (eater pointer)
+    CollisionMessageHandle message;  // kAnnounceMessage (see CollisionMessageArena)
+  };
 
-  // CRITICAL FIX: Store message inline instead of pointer to avoid dangling pointer bug
-  // Previously: const char* message (dangling pointer to stack memory)
-  // Now: char message_buffer[256] (owned storage)
-  char message_buffer[256];   // For kAnnounceMessage - inline storage prevents use-after-free
+  // Payload accessors for kSetVelocity / kSetPosition. Values are returned
+  // exactly as stored (no renormalization).
+  CTraj GetVelocity() const;
+  CCoord GetPosition() const;
 
   // Constructors for convenience
   CollisionCommand();
@@ -116,7 +143,7 @@ struct CollisionCommand {
   static CollisionCommand AdjustFuel(CThing* target, double delta);
   static CollisionCommand SetDocked(CThing* target, bool docked);
   static CollisionCommand RecordEatenBy(CThing* asteroid, CThing* ship);
-  static CollisionCommand Announce(const char* msg);
+  static CollisionCommand Announce(CollisionMessageHandle message);
 };
 
 // ============================================================================
@@ -194,6 +221,13 @@ struct CollisionContext {
   double random_separation_angle;     // Uniform random in [-π, π)
   bool random_separation_forward;     // When true, move along random angle; else use angle + π
 
+  // Per-tick storage for announcer text (owned by the world). NULL drops
+  // announcements, e.g. for contexts that only apply commands.
+  CollisionMessageArena* messages;
+
+  // Interns msg into messages for use with CollisionCommand::Announce()
+  CollisionMessageHandle InternMessage(const char* msg) const;
+
   // Constructor
   CollisionContext();
   CollisionContext(CWorld* w, const CollisionState* self, const CollisionState* other,
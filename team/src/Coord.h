@@ -9,6 +9,7 @@
 #define _COORD_H_DJFSELKFJHELFHLWKEJFHKLWEJHF
 
 #include "Sendable.h"
+#include "SerialFields.h"
 #include "stdafx.h"
 
 const double fWXMin = -512.0;
@@ -67,6 +68,9 @@ class CCoord : public CSendable {
   unsigned GetSerialSize() const;
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
+
+  typedef serial::Fields<serial::Field<&CCoord::fX>, serial::Field<&CCoord::fY>>
+      SerialFields;  // Wire layout
 };
 
 #endif  // !_COORD_H_DJFSELKFJHELFHLWKEJFHKLWEJHF
@@ -0,0 +1,42 @@
+/* EngineRandom.h
+ * Engine-private random number source for MechMania IV
+ * Replaces the C library rand() stream inside the simulation so that
+ * worlds can be seeded reproducibly and are not perturbed by team code
+ * (or other worlds) sharing the same process.
+ */
+
+#ifndef _ENGINE_RANDOM_H_MM4
+#define _ENGINE_RANDOM_H_MM4
+
+#include <random>
+
+namespace EngineRandom {
+
+// Drop-in replacement for rand(): returns a value in [0, RAND_MAX].
+int Rand();
+
+// Uniform value in [0.0, 1.0], equivalent to rand() / RAND_MAX.
+double Unit();
+
+// Reseed the generator currently active on this thread.
+void Seed(unsigned int seed);
+
+// Each thread starts with its own generator (seeded from std::random_device).
+// A Scope temporarily routes every draw on this thread to another generator,
+// so an in-process match can keep the server world's stream separate from
+// the streams used while building and updating each team's client world.
+class Scope {
+ public:
+  explicit Scope(std::mt19937& generator);
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  std::mt19937* previous_;
+};
+
+}  // namespace EngineRandom
+
+#endif  // _ENGINE_RANDOM_H_MM4
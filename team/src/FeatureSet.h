@@ -0,0 +1,132 @@
+/* FeatureSet.h
+ * Typed snapshot of the legacy/new feature flags
+ * For use with MechMania IV
+ *
+ * ArgumentParser keeps feature flags in a std::map keyed by name, which is
+ * convenient for config files and bundles but costs a string build and a
+ * map walk per query. CParser resolves the map into a FeatureSet once at
+ * startup; engine code queries it with CParser::UseNewFeature(Feature),
+ * which is a single load and mask.
+ *
+ * Engine code asks FeatureSet::Enabled(Feature), which reads g_pParser's set
+ * (the defaults if no parser is installed). Building with
+ * -DMM4_FIXED_FEATURES=default (or =legacy) in CMake bakes one profile in as
+ * a constant instead: Enabled() is then constexpr and the branches for the
+ * other behavior are compiled out; command-line feature flags are ignored
+ * with a warning.
+ */
+
+#ifndef _FEATURE_SET_H_MM4
+#define _FEATURE_SET_H_MM4
+
+#include <cstdint>
+
+// Compile-time profile selected by the MM4_FIXED_FEATURES CMake option
+#if defined(MM4_FIXED_FEATURES_DEFAULT) || defined(MM4_FIXED_FEATURES_LEGACY)
+#define MM4_FIXED_FEATURES 1
+#endif
+
+class ArgumentParser;
+
+// One entry per ArgumentParser feature name (see GetFeatureName). The value
+// follows UseNewFeature semantics: true means the "new" side of the flag,
+// which for laser-exploit and rangecheck-bug is the buggy legacy behavior.
+enum class Feature : unsigned int {
+  kCollisionDetection,         // "collision-detection"
+  kVelocityLimits,             // "velocity-limits"
+  kAsteroidEatDamage,          // "asteroid-eat-damage"
+  kAsteroidBounce,             // "asteroid-bounce"
+  kPhysics,                    // "physics"
+  kCollisionHandling,          // "collision-handling"
+  kCargoCalc,                  // "cargo-calc"
+  kShipDestruction,            // "ship-destruction"
+  kLaserExploit,               // "laser-exploit"
+  kDocking,                    // "docking"
+  kRangecheckBug,              // "rangecheck-bug"
+  kAnnouncerVelocityClamping,  // "announcer-velocity-clamping"
+  kInitialOrientation,         // "initial-orientation"
+  kFacingDetection,            // "facing-detection"
+  kCount
+};
+
+// Returns the ArgumentParser feature name
+const char* GetFeatureName(Feature feature);
+
+class FeatureSet {
+ public:
+  constexpr FeatureSet() : bits_(0) {}
+
+  constexpr bool Has(Feature feature) const {
+    return (bits_ & Bit(feature)) != 0;
+  }
+
+  constexpr FeatureSet With(Feature feature, bool enabled) const {
+    return FeatureSet(enabled ? (bits_ | Bit(feature)) : (bits_ & ~Bit(feature)));
+  }
+
+  constexpr bool operator==(const FeatureSet& other) const {
+    return bits_ == other.bits_;
+  }
+  constexpr bool operator!=(const FeatureSet& other) const {
+    return bits_ != other.bits_;
+  }
+
+  // Resolves every Feature through ArgumentParser::UseNewFeature
+  static FeatureSet FromParser(const ArgumentParser& parser);
+
+  // Whether the game runs with the "new" side of feature. Defined below
+  // for fixed builds, in ParserModern.h otherwise.
+#ifdef MM4_FIXED_FEATURES
+  static constexpr bool Enabled(Feature feature);
+#else
+  static bool Enabled(Feature feature);
+#endif
+
+  // Built-in profiles, matching ArgumentParser's defaults and its
+  // "legacy-mode" bundle
+  static constexpr FeatureSet Defaults() {
+    return FeatureSet()
+        .With(Feature::kCollisionDetection, true)
+        .With(Feature::kVelocityLimits, true)
+        .With(Feature::kAsteroidEatDamage, true)
+        .With(Feature::kAsteroidBounce, true)
+        .With(Feature::kPhysics, true)
+        .With(Feature::kCollisionHandling, true)
+        .With(Feature::kCargoCalc, true)
+        .With(Feature::kShipDestruction, true)
+        .With(Feature::kDocking, true)
+        .With(Feature::kInitialOrientation, true)
+        .With(Feature::kFacingDetection, true);
+  }
+  static constexpr FeatureSet LegacyMode() {
+    return FeatureSet()
+        .With(Feature::kLaserExploit, true)
+        .With(Feature::kRangecheckBug, true);
+  }
+
+ private:
+  constexpr explicit FeatureSet(uint32_t bits) : bits_(bits) {}
+
+  static constexpr uint32_t Bit(Feature feature) {
+    return uint32_t(1) << static_cast<unsigned int>(feature);
+  }
+
+  uint32_t bits_;
+};
+
+static_assert(static_cast<unsigned int>(Feature::kCount) <= 32,
+              "FeatureSet stores one bit per feature in a uint32_t");
+
+#if defined(MM4_FIXED_FEATURES_DEFAULT)
+constexpr FeatureSet kFixedFeatures = FeatureSet::Defaults();
+#elif defined(MM4_FIXED_FEATURES_LEGACY)
+constexpr FeatureSet kFixedFeatures = FeatureSet::LegacyMode();
+#endif
+
+#ifdef MM4_FIXED_FEATURES
+constexpr bool FeatureSet::Enabled(Feature feature) {
+  return kFixedFeatures.Has(feature);
+}
+#endif
+
+#endif  // _FEATURE_SET_H_MM4
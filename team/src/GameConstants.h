@@ -186,6 +186,11 @@ extern double g_no_collide_sentinel;
 // Sentinel used to indicate no damage direction has been recorded.
 extern double g_no_damage_sentinel;
 
+// Number of physics sub-ticks per game turn (g_game_turn_duration split into
+// g_physics_simulation_dt steps). At least 1 unless the timing constants are
+// invalid (<= 0), in which case it is 0.
+int GetPhysicsStepsPerTurn();
+
 // Initialize the global constants from the parser
 // This should be called after argument parsing
 void InitializeGameConstants(class ArgumentParser* parser);
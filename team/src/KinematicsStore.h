@@ -0,0 +1,63 @@
+/* KinematicsStore.h
+ * Structure-of-arrays drift integrator for non-ship things
+ * For use with MechMania IV
+ *
+ * CThing::Drift turns the polar velocity into a displacement (operator*,
+ * Normalize, cos/sin) and wraps the new position with two fmod calls, for
+ * every object on every physics sub-tick. Asteroids and stations have no
+ * orders, so CWorld::PhysicsModel hands them to this store instead:
+ *
+ *   Add()        does the per-object bookkeeping of CThing::Drift and
+ *                gathers position, displacement and spin into flat arrays.
+ *                The displacement is cached per world index and only
+ *                recomputed (exactly as Drift does) when rho, theta or dt
+ *                change, which for asteroids is only after a collision.
+ *   Integrate()  adds and wraps every position with an SSE2 kernel (scalar
+ *                loop elsewhere), then writes the results back.
+ *
+ * The wrap is CCoord::Normalize's fmod specialised to the one-world-width
+ * range Add() guarantees, and every step rounds the same way, so results
+ * are bit-identical to CThing::Drift. Things outside that range return
+ * false from Add() and the caller drifts them the usual way. CThing keeps
+ * owning Pos/Vel; the arrays only live for one sub-tick.
+ */
+
+#ifndef _KINEMATICS_STORE_H_MM4
+#define _KINEMATICS_STORE_H_MM4
+
+#include <vector>
+
+class CThing;
+
+class KinematicsStore {
+ public:
+  KinematicsStore();
+
+  // Start a sub-tick. capacity is the number of world index slots.
+  void Reset(unsigned int capacity);
+
+  // Queue thing for this sub-tick's drift. Returns false (with the thing
+  // untouched apart from Drift's idempotent prologue) if it must be drifted
+  // by CThing::Drift instead.
+  bool Add(CThing* thing, double dt);
+
+  // Integrate and write back everything queued since Reset()
+  void Integrate();
+
+ private:
+  // Displacement (Vel * dt).ConvertToCoord() for a given rho/theta/dt
+  struct DriftCache {
+    bool valid;
+    double rho, theta, dt;
+    double dx, dy;
+  };
+
+  std::vector<DriftCache> cache_;  // Indexed by world index
+
+  std::vector<CThing*> things_;
+  std::vector<double> x_, y_;
+  std::vector<double> dx_, dy_;
+  std::vector<double> orient_, dorient_;
+};
+
+#endif  // _KINEMATICS_STORE_H_MM4
@@ -0,0 +1,74 @@
+/* LaserTargetIndex.h
+ * Ray-query index behind CShip::LaserTarget
+ * For use with MechMania IV
+ *
+ * CShip::LaserTarget used to call IsFacing (VectTo, a normalized ray
+ * endpoint, several fmod/hypot/atan2 calls) on every thing in the world and
+ * keep the nearest hit. Team AIs ask it the same question many times per
+ * turn, so CWorld keeps this index of the world list and rebuilds it lazily
+ * after anything in the world moves.
+ *
+ * Things are binned by position into a uniform toroidal grid. A query
+ * walks the ray in half-cell steps, visits every cell within reach of it
+ * (reach = largest thing size, the furthest a hit's centre can lie from the
+ * ray), and stops once the walk is past the nearest hit found so far.
+ * Candidates go through a cheap Cartesian version of the facing test with
+ * a small slack, and only the survivors through the real CThing::IsFacing
+ * and CCoord::DistTo. The filter can only reject things IsFacing rejects,
+ * and ties go to the thing earlier in the world list, so the answer is
+ * exactly the one the full scan gives.
+ */
+
+#ifndef _LASER_TARGET_INDEX_H_MM4
+#define _LASER_TARGET_INDEX_H_MM4
+
+#include <vector>
+
+class CThing;
+
+class LaserTargetIndex {
+ public:
+  // 16 x 16 cells of 64 x 64 units over the 1024 x 1024 world
+  static const int kCellsPerSide = 16;
+
+  LaserTargetIndex();
+
+  bool IsBuilt() const { return built_; }
+  void Invalidate() { built_ = false; }
+
+  // Rebuild: Clear(), Add() every thing in world list order, then Finish()
+  void Clear();
+  void Add(CThing* thing);
+  void Finish();
+
+  // Nearest thing shooter IsFacing, as the full scan in CShip::LaserTarget
+  // finds it. Sets *dist to its DistTo, or to -1.0 if there is none.
+  CThing* FirstAlongHeading(const CThing& shooter, double* dist);
+
+ private:
+  struct Entry {
+    CThing* thing;
+    double x, y;
+    double size;
+  };
+
+  // Runs the real test on one candidate and keeps the better of it and the
+  // current best (nearest, then earliest in the world list)
+  void Consider(const CThing& shooter, unsigned int rank);
+
+  bool built_;
+  std::vector<Entry> entries_;        // World list order; rank = position
+  std::vector<unsigned int> strays_;  // Entries outside the world bounds
+  double max_size_;
+
+  std::vector<unsigned int> cells_[kCellsPerSide * kCellsPerSide];
+  unsigned int visited_[kCellsPerSide * kCellsPerSide];  // Query stamps
+  unsigned int stamp_;
+
+  // Best hit of the running query
+  CThing* best_;
+  unsigned int best_rank_;
+  double best_dist_;
+};
+
+#endif  // _LASER_TARGET_INDEX_H_MM4
@@ -0,0 +1,163 @@
+/* MatchLog.h
+ * Binary match recording and seekable replay
+ * For use with MechMania IV
+ *
+ * A server started with --record appends the game to a match log as it is
+ * played: every sub-tick's world, as the observer would be sent it, and
+ * the orders each team sent at the end of every turn. mm4replay maps the
+ * log and either plays it back to an observer from any turn, or plays the
+ * game again from the recorded orders to check that the engine still
+ * produces the same worlds.
+ *
+ * Layout (words are 4 bytes, network order; offsets are two words, high
+ * word first):
+ *
+ *   header   kMatchLogMagic, kMatchLogVersion, wire format, world seed,
+ *            the server's command line (count, then length + bytes per
+ *            argument) and the frames MeetTeams sent the observer (count,
+ *            then length + bytes per frame)
+ *   records  kind, turn, payload length, payload
+ *            MLOG_WORLD   sub-tick, then a SnapshotEncoder frame. The
+ *                         first sub-tick of every turn is a keyframe, so
+ *                         playback can start at any turn.
+ *            MLOG_ORDERS  per team: thinking time (exact double), order
+ *                         length (0 when none arrived) and the orders
+ *            MLOG_INDEX   per turn: turn, offset of its first world
+ *   trailer  offset of the MLOG_INDEX record, kMatchLogIndexMagic
+ *
+ * The index and trailer are only written by Close(). A log cut short by a
+ * crash is still readable: the reader rebuilds the index by walking the
+ * records and ignores a torn last record.
+ *
+ * Turn N's worlds are the sub-ticks that take the world from turn N-1 to
+ * N, and its orders are the ones the teams sent after seeing turn N.
+ */
+
+#ifndef _MATCH_LOG_H_MM4
+#define _MATCH_LOG_H_MM4
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "WorldSnapshot.h"
+
+const unsigned int kMatchLogMagic = 0x4D344D4C;       // "M4ML"
+const unsigned int kMatchLogIndexMagic = 0x4D344D49;  // "M4MI"
+const unsigned int kMatchLogVersion = 1;
+
+enum MatchRecordKind {
+  MLOG_WORLD = 1,
+  MLOG_ORDERS = 2,
+  MLOG_INDEX = 3
+};
+
+class MatchRecorder {
+ public:
+  MatchRecorder();
+  ~MatchRecorder();  // Close()s
+
+  bool Open(const char* path);  // Creates (or truncates) the log
+
+  // Writes the header; call once, before any records
+  void Start(unsigned int seed, const std::vector<std::string>& args,
+             const std::vector<std::vector<char>>& hello);
+
+  // Records one sub-tick's world image (teamlen bytes of team block after
+  // the fixed header)
+  void AddWorld(unsigned int turn, unsigned int step, const char* image,
+                unsigned int len, unsigned int teamlen);
+
+  // Orders are collected per team as they arrive, then written together
+  // with every team's thinking time once the turn's orders are in
+  void SetOrders(unsigned int team, const char* buf, unsigned int len);
+  void AddOrders(unsigned int turn, const double* clocks,
+                 unsigned int numTeams);
+
+  void Close();  // Writes the index and trailer
+
+  bool IsOpen() const { return fp_ != NULL; }
+
+ private:
+  void Put(const void* data, size_t len);
+  void PutWord(unsigned int val);
+  void PutRecord(unsigned int kind, unsigned int turn, unsigned int len);
+
+  FILE* fp_;
+  uint64_t pos_;  // Bytes written so far
+  bool started_;
+
+  SnapshotEncoder encoder_;
+
+  std::vector<std::vector<char>> orders_;  // Per team, this turn
+  std::vector<bool> gotorders_;
+
+  struct IndexEntry {
+    unsigned int turn;
+    uint64_t pos;
+  };
+  std::vector<IndexEntry> index_;
+};
+
+// One record of a mapped log; data points into the mapping
+struct MatchRecord {
+  unsigned int kind, turn;
+  unsigned int step;  // MLOG_WORLD only
+  const char* data;   // Payload after the step word for worlds
+  unsigned int len;
+};
+
+class MatchLog {
+ public:
+  MatchLog();
+  ~MatchLog();
+
+  // Maps the log and reads its header and index. Returns false, with the
+  // reason in *error, if it isn't a match log.
+  bool Open(const char* path, std::string* error);
+
+  unsigned int GetWireFormat() const { return wire_; }
+  unsigned int GetSeed() const { return seed_; }
+  const std::vector<std::string>& GetArgs() const { return args_; }
+  const std::vector<std::vector<char>>& GetHello() const { return hello_; }
+
+  size_t GetSize() const { return size_; }
+  bool HasIndex() const { return indexed_; }  // False if rebuilt by a scan
+
+  // Recorded turns are GetFirstTurn() .. GetLastTurn(); none if first > last
+  unsigned int GetFirstTurn() const { return firstturn_; }
+  unsigned int GetLastTurn() const {
+    return firstturn_ + (unsigned int)turnpos_.size() - 1;
+  }
+
+  size_t Begin() const { return records_; }  // Position of the first record
+
+  // Position of turn's first world, its keyframe; 0 if it wasn't recorded
+  size_t Seek(unsigned int turn) const;
+
+  // Reads the record at *pos and moves *pos past it. Returns false at the
+  // end of the records.
+  bool Next(size_t* pos, MatchRecord* rec) const;
+
+ private:
+  bool ReadHeader(std::string* error);
+  bool ReadIndex();  // From the trailer
+  void ScanIndex();  // By walking the records
+
+  int fd_;
+  const char* map_;
+  size_t size_;
+
+  unsigned int wire_, seed_;
+  std::vector<std::string> args_;
+  std::vector<std::vector<char>> hello_;
+
+  size_t records_, end_;  // Where the records start and stop
+  bool indexed_;
+  unsigned int firstturn_;
+  std::vector<uint64_t> turnpos_;  // By turn - firstturn_
+};
+
+#endif  // _MATCH_LOG_H_MM4
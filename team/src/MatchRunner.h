@@ -0,0 +1,89 @@
+/* MatchRunner.h
+ * In-process headless match engine for MechMania IV
+ *
+ * Plays a complete game between linked-in team factories without sockets,
+ * server/client processes or an observer. The turn pipeline mirrors the
+ * networked game exactly: the server world is serialized into each team's
+ * private client world, the team's Turn() runs against that copy, and its
+ * packed orders are unpacked into the server-side team. With the same seed
+ * (mm4serv --seed) and deterministic team code the final GetVinylStore()
+ * scores match a networked game. Teams whose decisions depend on heap
+ * addresses (e.g. iterating a std::set<CThing*>) or on process-wide static
+ * state are not deterministic across processes and will diverge.
+ *
+ * Team factories have the CTeam::CreateTeam() signature. An executable that
+ * links a single team can pass &CTeam::CreateTeam for every slot; different
+ * teams must come from separately linked factories (see mm4batch).
+ *
+ * The caller owns global configuration: g_pParser and the g_* game constants
+ * must be initialized (e.g. by constructing a CParser) before a match runs.
+ */
+
+#ifndef _MATCH_RUNNER_H_MM4
+#define _MATCH_RUNNER_H_MM4
+
+#include <random>
+#include <string>
+#include <vector>
+
+class CTeam;
+class CWorld;
+
+typedef CTeam* (*TeamFactory)(void);
+
+struct MatchResult {
+  unsigned int seed = 0;
+  unsigned int turns = 0;                // Turns actually simulated
+  std::vector<std::string> team_names;   // As reported in each team's init data
+  std::vector<double> scores;            // Station vinyl per team slot
+  std::vector<double> think_seconds;     // Wall clock spent in each team's Turn()
+  std::vector<bool> timed_out;           // True if the team exceeded its time budget
+};
+
+class MatchRunner {
+ public:
+  // One factory per team slot; slot i plays from station position i.
+  MatchRunner(const std::vector<TeamFactory>& factories, unsigned int seed);
+  ~MatchRunner();
+
+  MatchRunner(const MatchRunner&) = delete;
+  MatchRunner& operator=(const MatchRunner&) = delete;
+
+  // Plays until g_game_max_turns and returns the final result.
+  MatchResult Run();
+
+  // Simulates one turn and collects the teams' next orders. Returns false
+  // (and does nothing) once the game has reached g_game_max_turns.
+  bool PlayTurn();
+
+  MatchResult GetResult() const;
+  CWorld* GetWorld() const { return server_world_; }
+
+ protected:
+  // Team-side state: a private world copy and the team objects created by
+  // that team's factory, as a networked client process would hold them.
+  struct ClientSlot {
+    CWorld* world = nullptr;
+    std::vector<CTeam*> teams;
+    std::mt19937 rng;
+    bool active = true;
+  };
+
+  void MeetTeams();
+  void Simulation();
+  void BroadcastWorld();
+  void ReceiveTeamOrders();
+
+  unsigned int seed_;
+  unsigned int num_teams_;
+
+  CWorld* server_world_;
+  std::vector<CTeam*> server_teams_;
+  std::mt19937 server_rng_;
+
+  std::vector<ClientSlot> clients_;
+  std::vector<char> world_buf_;
+  std::vector<char> order_buf_;
+};
+
+#endif  // _MATCH_RUNNER_H_MM4
@@ -4,6 +4,19 @@
 // base networking class.
 //
 // connection numbers start at 1
+//
+// Sockets are non-blocking and watched by one edge-triggered epoll set.
+// Each connection has a growable input buffer that Poll() drains the socket
+// into, and an output queue for whatever a send could not write at once;
+// nothing is truncated or dropped. Messages in both directions are frames:
+// a 4-byte network-order length followed by that many bytes.
+//
+// A connection over a unix socket reaches a peer on the same host. Each end
+// of one hands the other its ShmRing, and from then on a frame of any size
+// is copied into the sender's ring once and only a short descriptor goes
+// through the socket. The descriptor's arrival is what wakes the reader, so
+// the event loop and disconnect handling work as for any other connection.
+// Callers see the same frames either way.
 
 #ifndef __CNetwork__
 #define __CNetwork__
@@ -13,8 +26,15 @@
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 
+#include <stdint.h>
+
+#include <vector>
+
+class ShmRing;
+
 const char n_oback[] = "ObReady!";            // Observer acknowledge string
 const char n_servconack[] = "Conn MM4 Serv";  // Connect ack
 const char n_obcon[] = "Observer Conned";     // Connect observer
@@ -24,63 +44,153 @@ const char n_teamcon[] =
 const char n_pause[] = "ObPause!";    // Observer-initiated pause
 const char n_resume[] = "ObResume!";  // Observer-initiated resume
 
+// A client identifies itself with n_obcon or n_teamcon followed by a 4-byte
+// network-order word: the newest WireFormat (see Sendable.h) it can read.
+// Without the word it reads only WIRE_FIXED_POINT. Returns true if frame is
+// the ident and sets *wire.
+bool ParseIdent(const char *frame, unsigned int len, const char *ident,
+                unsigned int *wire);
+
+// A server on port also listens on this unix socket, for clients on the
+// same host. Returns the address length.
+socklen_t LocalServerAddr(int port, struct sockaddr_un *addr);
+
+// Largest frame either side accepts; a peer announcing more is dropped
+const unsigned int kMaxFrameLen = 64 * 1024 * 1024;
+
 class CNetwork {
  private:
-  int *fds;  // connection file descriptors
-  int *timeout;
+  // Bytes [head, tail) of data are pending. Grows as needed and compacts
+  // when the free space at the end runs short.
+  struct ConnBuf {
+    std::vector<char> data;
+    size_t head = 0, tail = 0;
+
+    size_t Length() const { return tail - head; }
+    void Append(const char *src, size_t len);
+    void Consume(size_t len);
+    char *Reserve(size_t len);  // Room for len more bytes at tail
+  };
+
+  struct Conn {
+    int fd = 0;
+    int timeout = -1;
+    ConnBuf in, out;
+    unsigned int held = 0;  // Bytes of the frame last handed out by RecvFrame
+
+    // Shared-memory link, for a unix socket
+    bool local = false;    // May pass descriptors
+    bool offered = false;  // Peer has been sent our ring
+    std::vector<int> fds;  // Received with a frame, not yet claimed
+    ShmRing *peer = NULL;  // Peer's ring, read-only
+    unsigned int myslot = 0;    // Where our ring reports reading the peer's
+    unsigned int peerslot = 0;  // Where the peer's ring reports reading ours
+    uint64_t sentend = 0;  // End of the last frame put in our ring for it
+    uint64_t heldend = 0;  // End in the peer's ring of the held frame, if any
+  };
+
+  std::vector<Conn> conns;
   int maxconn;
-
-  int maxqlen, *queuelen;
-  char **queue, *queuebuf;
+  int initqlen;  // Initial size of each input buffer
 
   int next_conn;
-  int max_fd;
+  int epfd;
+
+  ShmRing *ring;  // Ours; created with the first link offer
+  unsigned int next_slot;
 
-  fd_set sockets_fds;
+  void ReadConn(int conn);   // Drain the socket into the input buffer
+  void FlushConn(int conn);  // Write as much queued output as the socket takes
+  void ReleaseFrames();      // Consume frames handed out by RecvFrame
+  int Send(int conn, const char *prefix, unsigned int prefixlen,
+           const char *data, unsigned int len);
 
-  int fd2conn(int fd);
-  int RecvPktWithTimeout(char *data, int &len, const timeval &timeout);
+  bool PutInRing(const char *data, unsigned int len, uint64_t *pos);
+  int SendRingFrame(int conn, uint64_t pos, unsigned int len);
+
+  // Handles a link frame. Returns the frame it carries, or NULL with *bad
+  // set if it's malformed (NULL alone for a ring offer).
+  const char *TakeLinkFrame(int conn, const char *payload, unsigned int plen,
+                            unsigned int *len, bool *bad);
 
  protected:
   int NewConn(int fd);
   void CloseConn(int conn);
 
+  // Sends conn our ring, if conn is a unix socket. Returns true if it went.
+  bool OfferLink(int conn);
+
+  // Takes conn's socket out of the event loop and hands it to the caller,
+  // along with its unread input and unsent output. conn reads as closed
+  // afterwards. Returns the socket, or 0 if the connection was closed.
+  int ReleaseConn(int conn, std::vector<char> *in, std::vector<char> *out);
+
   friend class CServer;
 
  public:
   // CNetwork
   //    themaxconn - maximum number of connections
-  //    thequeuelen - max size of queue for each connection
+  //    thequeuelen - initial input buffer size for each connection
   //
   // Constructs the network object to handle maxconn connections
   CNetwork(int themaxconn, int thequeuelen);
-  virtual ~CNetwork();
+  virtual ~CNetwork();  // Waits briefly for queued output to go out
 
   // SendPkt
   //   data - characters to send
   //   len - lengh of the data to send
   //
-  // SendPkt send the data to the specified connectios
+  // SendPkt sends raw, unframed data to the specified connection. Whatever
+  // the socket does not take at once is queued and written by Poll().
   // retuns 0 on success
   int SendPkt(int conn, const char *data, int len);
 
-  // RecvPkt
-  //   data - buffer to write packet into
-  //   len - max size of data
+  // SendFrame
+  //   data - characters to send
+  //   len - length of the data to send
+  //
+  // SendFrame sends len as a 4-byte network-order prefix followed by the
+  // data, so callers can hand the same buffer to every connection without
+  // copying the prefix in front of it. Queues like SendPkt.
+  // returns 0 on success
+  int SendFrame(int conn, const char *data, unsigned int len);
+
+  // SendFrameToAll
+  //   targets - connections to send to
+  //
+  // Sends the same frame to each connection in conns. Linked peers all read
+  // it from a single copy in our ring.
+  void SendFrameToAll(const std::vector<int> &targets, const char *data,
+                      unsigned int len);
+
+  // True if frames to conn go through our ring
+  bool IsShared(int conn) const;
+
+  // RecvFrame
+  //   len - set to the length of the frame
+  //   timeout_ms - how long to wait for it; -1 waits forever, 0 only takes
+  //                what has already arrived
+  //
+  // RecvFrame returns the next frame from conn, or NULL on timeout or once
+  // the connection has closed with no complete frame left. The frame stays
+  // valid until the next RecvFrame or Poll call. A frame from a linked peer
+  // is in its ring, which is mapped read-only.
+  char *RecvFrame(int conn, unsigned int *len, int timeout_ms = -1);
+
+  // True if a complete frame from conn is waiting
+  bool HasFrame(int conn) const;
+
+  // Poll
+  //   timeout_ms - how long to wait for network events; -1 waits forever
   //
-  // RecvPkt waits to recive a packet less then or equal in length to
-  // len.  RecvPkt sets len to the amout of data it read and returns
-  // the connection number from which it read.  If length is less than
-  // one a timeout has occured.
-  int RecvPkt(char *data, int &len);
-  int RecvPktNonBlocking(char *data, int &len);
-
-  // Misha's crazy queue-related stuff
-  int CatchPkt();  // Waits for pkt, adds to appropriate conn queue
-  int CatchPktNonBlocking();  // Attempts to grab pkt without blocking
-  int GetQueueLength(int conn = 1);  // Returns amt of data in queue #conn
-  char *GetQueue(int conn = 1);      // Returns ptr to bottom of queue #conn
-  void FlushQueue(int conn = 1);     // Empties data out of queue #conn
+  // Runs the event loop once: reads every readable connection into its
+  // buffer, writes queued output, and notices closed connections.
+  // Returns the number of events handled (0 on timeout).
+  int Poll(int timeout_ms);
+
+  // Polls until every output queue is empty or timeout_ms has passed.
+  // Returns true if everything was written.
+  bool Flush(int timeout_ms);
 
   void SetTimeout(int conn, int thetimeout);
 
@@ -29,6 +29,7 @@ class ObserverSDL {
   SpriteManager* spriteManager;
   CWorld* myWorld;
   SDL_Texture* logoTexture;
+  SDL_Texture* starTexture;  // The starfield, drawn once
 
   // Display settings
   bool useXpm;
@@ -149,6 +150,7 @@ class ObserverSDL {
     }
   }
   CWorld* GetWorld() { return myWorld; }
+  SDL2Graphics* GetGraphics() { return graphics; }
 
   // Settings
   void SetAttractor(int val) { attractor = val; }
@@ -0,0 +1,148 @@
+/* ObserverStream.h
+ * Asynchronous world stream to the observer and spectators
+ * For use with MechMania IV
+ *
+ * The server used to send the observer a world after every physics
+ * sub-tick and then wait for its ack, so the whole game ran at the speed
+ * of the observer's render loop. Once the teams have been introduced, an
+ * ObserverStream takes over the observer's socket instead. The simulation
+ * Publish()es world images into a small ring buffer and carries on; a
+ * sender thread encodes each one once (keyframe or delta, see
+ * WorldSnapshot.h) and fans the result out to every viewer.
+ *
+ * Viewers share the frames: each keeps a queue of references to the same
+ * buffers and writes the length prefix and the shared bytes with one
+ * sendmsg, so the server's cost per frame does not grow with the number
+ * of viewers. A viewer gets at most a couple of frames ahead of its acks.
+ * One that falls further behind has its queued worlds dropped and is sent
+ * the next world whole, since the deltas in between no longer apply.
+ *
+ * The stream can also own the server's listening socket (relay mode).
+ * Spectators then connect at any time with the usual observer handshake;
+ * they are sent the team introduction MeetTeams sent the observer, then
+ * the latest world whole, and then the live frames.
+ *
+ * Only the controlling observer (the one that connected with the teams)
+ * can pause and resume the game; the server picks that up through
+ * IsPaused(). In lockstep mode the stream only takes a frame once the
+ * controller has acked the last one and Publish() waits for room rather
+ * than dropping, which paces the game by the observer as before.
+ */
+
+#ifndef _OBSERVER_STREAM_H_MM4
+#define _OBSERVER_STREAM_H_MM4
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WorldSnapshot.h"
+
+// An observer connection taken over from CNetwork::ReleaseConn
+struct ObserverConn {
+  int fd;
+  std::vector<char> in, out;  // Unread input, unsent output
+};
+
+class ObserverStream {
+ public:
+  // hello - frames a new spectator is sent after its ack: the world
+  //         introduction and each team's init data
+  // keyframe_interval - as for SnapshotEncoder
+  // lockstep - pace the game by the controlling observer
+  ObserverStream(const std::vector<std::vector<char>>& hello,
+                 unsigned int keyframe_interval, bool lockstep);
+  ~ObserverStream();  // Gives queued frames a moment to go out, then closes
+
+  // Setup, before Start(). The stream owns the sockets from here on.
+  void AddController(ObserverConn conn, bool paused);  // Already introduced
+  void AddSpectator(ObserverConn conn);  // Identified, not yet introduced
+  void Listen(int fd);                   // Accept spectators on fd
+  void Start();
+
+  // Copies image (teamlen bytes of team block after the fixed header) into
+  // the ring. Only waits on the observer in lockstep mode.
+  void Publish(const char* image, unsigned int len, unsigned int teamlen);
+
+  // Waits up to timeout_ms for the controller to pause, resume or go away
+  void WaitForControl(int timeout_ms);
+
+  // Waits up to timeout_ms for every published frame to be sent and acked.
+  // Returns true if they were.
+  bool Drain(int timeout_ms);
+
+  bool IsOpen() const;         // Anyone watching, or able to join
+  bool HasController() const;  // Controlling observer still connected
+  bool IsPaused() const;
+
+  unsigned int GetSentCount() const;     // Frames taken from the ring
+  unsigned int GetOverrunCount() const;  // Frames viewers lost unsent
+  unsigned int GetDroppedCount() const;  // Frames some viewer missed
+  unsigned int GetViewerCount() const;
+
+ private:
+  typedef std::shared_ptr<const std::vector<char>> Frame;
+
+  struct Slot {
+    std::vector<char> image;
+    unsigned int len = 0, teamlen = 0;
+  };
+
+  struct Out {
+    Frame data;
+    bool acked;  // Counts against the viewer's window until acked
+    bool world;  // May be dropped when the viewer falls behind
+    bool bare;   // Already framed (output left over from CNetwork)
+  };
+
+  struct Viewer {
+    int fd = -1;
+    bool control = false;  // May pause and resume the game
+    bool joined = false;   // Identified as an observer
+    bool resync = true;    // Next world goes out whole
+    unsigned int inflight = 0;  // Acked frames sent but not yet acked
+    unsigned int worlds = 0;    // World frames queued
+    std::vector<char> in;
+    std::deque<Out> queue;
+    size_t pos = 0;  // Bytes of queue.front() written, prefix included
+  };
+
+  void Run();  // Sender thread
+  bool TakeFrame();  // Encodes the oldest ring frame and queues it
+  void QueueWorld(Viewer* v, const Frame& raw, const Frame& frame);
+  void Welcome(Viewer* v);  // Queues the ack and the team introduction
+  void Accept();
+  bool WriteViewer(Viewer* v);  // False once the socket has failed
+  bool ReadViewer(Viewer* v);   // False once the socket has closed
+  bool ParseViewer(Viewer* v);  // Handles complete frames in v->in
+  void CloseViewer(Viewer* v);
+  void UpdateStatus();
+  void Wake();  // Gets the sender thread out of poll()
+  void Recycle(const std::vector<char>* image);  // Last Frame of it released
+
+  int listenfd_, wakefd_;
+  unsigned int window_;  // Frames a viewer may have out ahead of its acks
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;  // Ring, ack and control changes
+  std::vector<Slot> ring_;
+  std::vector<std::vector<char>> spare_;  // Sent images, for Publish()
+  unsigned int head_, count_;
+  unsigned int control_;  // Bumped on every pause, resume or close
+  unsigned int sent_, overrun_, dropped_, viewers_;
+  bool lockstep_, open_, busy_, controller_, paused_, stopping_;
+
+  // Sender thread only, until Start() for the setup calls
+  SnapshotEncoder encoder_;
+  std::vector<Frame> hello_;
+  Frame servconack_, obsack_;
+  Frame latest_;  // Last world taken, whole: the base of the next delta
+  std::vector<std::unique_ptr<Viewer>> viewerlist_;
+
+  std::thread thread_;
+};
+
+#endif  // _OBSERVER_STREAM_H_MM4
@@ -9,6 +9,7 @@
 #include <optional>
 
 #include "ArgumentParser.h"
+#include "FeatureSet.h"
 
 // CParser wrapper for backward compatibility
 // This allows existing code to work without modification
@@ -29,6 +30,17 @@ class CParser {
     return parser.UseNewFeature(feature);
   }
 
+  // Same answer as the string form, read from the FeatureSet resolved at
+  // construction. Engine code asks FeatureSet::Enabled() instead.
+#ifdef MM4_FIXED_FEATURES
+  static constexpr bool UseNewFeature(Feature feature) {
+    return kFixedFeatures.Has(feature);
+  }
+#else
+  bool UseNewFeature(Feature feature) const { return features_.Has(feature); }
+#endif
+  const FeatureSet& GetFeatures() const { return features_; }
+
   bool IsTeamLoggingEnabled() const { return parser.enableTeamLogging; }
   const std::string& GetTeamLogFile() const { return parser.teamLogFile; }
   const std::string& GetTeamParamsFile() const {
@@ -42,6 +54,15 @@ class CParser {
   std::optional<uint32_t> GetPlaylistSeed() const {
     return parser.playlistSeedOverride;
   }
+  std::optional<uint32_t> GetGameSeed() const {
+    return parser.gameSeedOverride;
+  }
+  bool KeyframesOnly() const { return parser.keyframesOnly; }
+  bool ObserverLockstep() const { return parser.observerLockstep; }
+  bool Spectators() const { return parser.spectators; }
+  bool FullPrecision() const { return parser.fullPrecision; }
+  const std::string& GetRecordFile() const { return parser.recordFile; }
+  bool TcpOnly() const { return parser.tcpOnly; }
   std::optional<int> GetAudioLeadMilliseconds() const {
     return parser.audioLeadMillisecondsOverride;
   }
@@ -55,6 +76,16 @@ class CParser {
 
  private:
   ArgumentParser parser;
+  FeatureSet features_;
 };
 
+#ifndef MM4_FIXED_FEATURES
+extern CParser* g_pParser;
+
+inline bool FeatureSet::Enabled(Feature feature) {
+  return g_pParser ? g_pParser->UseNewFeature(feature)
+                   : Defaults().Has(feature);
+}
+#endif
+
 #endif  // _PARSER_MODERN_H_MM4
@@ -8,6 +8,7 @@
 
 #include "Coord.h"
 #include "Traj.h"
+#include "Vec2.h"
 
 namespace PhysicsUtils {
 
@@ -15,6 +16,8 @@ struct ElasticCollisionResult {
   CTraj v1_final;         // Final velocity of object 1
   CTraj v2_final;         // Final velocity of object 2
   CTraj collision_normal; // Unit vector from object 1 toward object 2
+  CVec2 v1_final_cart;    // v1_final before the polar conversion
+  CVec2 v2_final_cart;    // v2_final before the polar conversion
   bool used_random_normal;
 };
 
@@ -10,9 +10,11 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "stdafx.h"
 
@@ -23,6 +25,15 @@ struct Color {
       : r(r), g(g), b(b), a(a) {}
 };
 
+// Text cache counts for one frame (Present() to Present())
+struct TextCacheStats {
+  unsigned int hits;       // DrawText calls drawn from a cached texture
+  unsigned int misses;     // DrawText calls that rendered their string
+  unsigned int evictions;  // Textures dropped to make room
+  unsigned int entries;    // Textures cached when the frame ended
+  TextCacheStats() : hits(0), misses(0), evictions(0), entries(0) {}
+};
+
 class SDL2Graphics {
  private:
   SDL_Window* window;
@@ -57,6 +68,49 @@ class SDL2Graphics {
   // Image cache
   std::map<std::string, SDL_Texture*> imageCache;
 
+  // Text cache: a texture per string drawn, most recently drawn first.
+  // The observer redraws the same panel lines, announcer messages and
+  // footer every frame, so nearly every DrawText is one SDL_RenderCopy.
+  static const size_t kTextCacheEntries = 512;
+  struct TextKey {
+    TTF_Font* font;
+    int style;  // TTF_GetFontStyle; the bold fonts may be synthetic
+    Uint32 rgba;
+    std::string text;
+    bool operator<(const TextKey& o) const;
+  };
+  struct TextEntry {
+    TextKey key;
+    SDL_Texture* texture;
+    int w, h;
+  };
+  std::list<TextEntry> textLru;
+  std::map<TextKey, std::list<TextEntry>::iterator> textCache;
+  TextCacheStats textFrameStats;  // This frame so far
+  TextCacheStats textLastStats;   // The last frame presented
+  void ClearTextCache();
+
+  // Primitive batches. Pixels and one-pixel-high spans of one color
+  // collect here and go to the renderer in one call each, when the color
+  // changes or before anything else is drawn (or the target changes), so
+  // drawing order is kept.
+  std::vector<SDL_Point> pointBatch;
+  std::vector<SDL_Rect> spanBatch;
+  Color batchColor;
+  void BatchColor(const Color& c);  // Flushes if c differs
+  void FlushBatches();
+
+  // Circle pixels by radius, relative to the centre: the outline as
+  // DrawCircle traces it and the filled disc as spans
+  std::map<int, std::vector<SDL_Point>> circleOutlines;
+  std::map<int, std::vector<SDL_Rect>> circleSpans;
+  const std::vector<SDL_Point>& CircleOutline(int radius);
+  const std::vector<SDL_Rect>& CircleSpans(int radius);
+
+  // cos and sin of k * kArcStep, as far as DrawArc has needed
+  static constexpr double kArcStep = 0.01;
+  std::vector<double> arcCos, arcSin;
+
   // Helper functions
   SDL_Color ColorToSDL(const Color& c) const;
   void SetDrawColor(const Color& c);
@@ -95,6 +149,10 @@ class SDL2Graphics {
   // Extended: measure with bold selection to match DrawText rendering
   void GetTextSizeEx(const std::string& text, int& w, int& h,
                      bool small = false, bool bold = false);
+  const TextCacheStats& GetTextCacheStats() const { return textLastStats; }
+  // After SDL_RENDER_DEVICE_RESET: drops cached text, whose textures died
+  // with the device
+  void DeviceReset();
 
   // Image handling
   SDL_Texture* LoadImage(const std::string& path);
@@ -121,7 +179,10 @@ class SDL2Graphics {
   int GetDisplayHeight() const { return displayHeight; }
   int GetSpaceWidth() const { return spaceWidth; }
   int GetSpaceHeight() const { return spaceHeight; }
-  SDL_Renderer* GetRenderer() { return renderer; }
+  SDL_Renderer* GetRenderer() {
+    FlushBatches();  // Caller draws directly from here on
+    return renderer;
+  }
 };
 
 #endif  // _SDL2GRAPHICS_H_
@@ -10,6 +10,14 @@
 
 #include "stdafx.h"
 
+// How doubles go over the wire. The handshake settles on one format for
+// the whole game; the process then packs and unpacks everything in it.
+enum WireFormat {
+  WIRE_FIXED_POINT = 0,     // int(x*1000), 4 bytes: the original protocol
+  WIRE_FULL_PRECISION = 1,  // IEEE-754 bits, 8 bytes: copies are exact
+  WIRE_NEWEST = WIRE_FULL_PRECISION
+};
+
 class CSendable {
  public:
   CSendable();
@@ -30,6 +38,14 @@ class CSendable {
   unsigned BufRead(char* src, bool& dest) const;
   unsigned BufRead(char* src, unsigned int& dest) const;
   unsigned BufRead(char* src, double& dest) const;
+
+  // Process-wide; set it before other threads pack or unpack anything
+  static void SetWireFormat(WireFormat format);
+  static WireFormat GetWireFormat();
+  static unsigned GetDoubleSize();  // Bytes a double takes on the wire
+
+ private:
+  static WireFormat wireFormat;
 };
 
 #endif  // _SENDABLE_H_SKLDJFNWLEJKFHKLWEHFLKWEHFKLJ
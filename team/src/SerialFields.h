@@ -0,0 +1,332 @@
+/* SerialFields.h
+ * Field lists for CSendable serialization
+ * For use with MechMania IV
+ *
+ * A class whose image is a fixed set of its members names them once, in
+ * wire order:
+ *
+ *   typedef serial::Fields<serial::Field<&CStation::dCargo>> SerialFields;
+ *
+ * and builds GetSerialSize, SerialPack and SerialUnpack from that list with
+ * serial::Size, serial::Pack and serial::Unpack, so the three can no longer
+ * disagree. A derived class appends its own members to its base's list with
+ * serial::Extend and packs the whole record in one go.
+ *
+ * Sizes are worked out at compile time for each wire format, and Pack and
+ * Unpack are instantiated once per format: the format is looked at once per
+ * record, and the fields go out as a straight run of stores with no calls
+ * or size checks in between.
+ *
+ * How member types go on the wire (words are 4 bytes, network order):
+ *   unsigned int, bool, enums   one word
+ *   double                      4 or 8 bytes, as the wire format says
+ *   char[N]                     N raw bytes
+ *   T[N]                        N of T
+ *   a class with SerialFields   its fields, inline
+ * Biased<M, b> sends int member M as the word M+b, and Zip<A, B> sends
+ * arrays A and B interleaved, A[0] B[0] A[1] B[1] ...
+ */
+
+#ifndef _SERIAL_FIELDS_H_MM4
+#define _SERIAL_FIELDS_H_MM4
+
+#include <endian.h>
+#include <netinet/in.h>
+#include <stdint.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include "Sendable.h"
+
+namespace serial {
+
+//////////////////////////////////////////
+// Encoding of one value
+
+inline char* PutWord(char* dst, unsigned int val) {
+  val = htonl(val);
+  memcpy(dst, &val, sizeof(val));
+  return dst + sizeof(val);
+}
+
+inline const char* GetWord(const char* src, unsigned int* val) {
+  memcpy(val, src, sizeof(*val));
+  *val = ntohl(*val);
+  return src + sizeof(*val);
+}
+
+template <typename T, typename = void>
+struct HasFields : std::false_type {};
+template <typename T>
+struct HasFields<T, std::void_t<typename T::SerialFields>> : std::true_type {};
+
+// Codec<W, T>: kSize bytes of T in wire format W, and Put/Get returning the
+// position after them
+template <WireFormat W, typename T, typename = void>
+struct Codec;
+
+template <WireFormat W>
+struct Codec<W, unsigned int> {
+  static constexpr unsigned kSize = 4;
+  static char* Put(char* dst, unsigned int val) { return PutWord(dst, val); }
+  static const char* Get(const char* src, unsigned int& val) {
+    return GetWord(src, &val);
+  }
+};
+
+template <WireFormat W>
+struct Codec<W, bool> {
+  static constexpr unsigned kSize = 4;
+  static char* Put(char* dst, bool val) {
+    return PutWord(dst, (unsigned int)val);
+  }
+  static const char* Get(const char* src, bool& val) {
+    unsigned int word;
+    src = GetWord(src, &word);
+    val = (bool)word;
+    return src;
+  }
+};
+
+template <WireFormat W, typename E>
+struct Codec<W, E, std::enable_if_t<std::is_enum<E>::value>> {
+  static constexpr unsigned kSize = 4;
+  static char* Put(char* dst, E val) { return PutWord(dst, (unsigned int)val); }
+  static const char* Get(const char* src, E& val) {
+    unsigned int word;
+    src = GetWord(src, &word);
+    val = (E)word;
+    return src;
+  }
+};
+
+template <>
+struct Codec<WIRE_FIXED_POINT, double> {
+  static constexpr unsigned kSize = 4;
+  static char* Put(char* dst, double val) {
+    return PutWord(dst, (unsigned int)(int)(val * 1000.0));
+  }
+  static const char* Get(const char* src, double& val) {
+    unsigned int word;
+    src = GetWord(src, &word);
+    val = ((double)(int)word) / 1000.0;
+    return src;
+  }
+};
+
+template <>
+struct Codec<WIRE_FULL_PRECISION, double> {
+  static constexpr unsigned kSize = 8;
+  static char* Put(char* dst, double val) {
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    bits = htobe64(bits);
+    memcpy(dst, &bits, sizeof(bits));
+    return dst + sizeof(bits);
+  }
+  static const char* Get(const char* src, double& val) {
+    uint64_t bits;
+    memcpy(&bits, src, sizeof(bits));
+    bits = be64toh(bits);
+    memcpy(&val, &bits, sizeof(bits));
+    return src + sizeof(bits);
+  }
+};
+
+template <WireFormat W, size_t N>
+struct Codec<W, char[N]> {
+  static constexpr unsigned kSize = N;
+  static char* Put(char* dst, const char (&val)[N]) {
+    memcpy(dst, val, N);
+    return dst + N;
+  }
+  static const char* Get(const char* src, char (&val)[N]) {
+    memcpy(val, src, N);
+    return src + N;
+  }
+};
+
+template <WireFormat W, typename T, size_t N>
+struct Codec<W, T[N], std::enable_if_t<!std::is_same<T, char>::value>> {
+  static constexpr unsigned kSize = N * Codec<W, T>::kSize;
+  static char* Put(char* dst, const T (&val)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+      dst = Codec<W, T>::Put(dst, val[i]);
+    }
+    return dst;
+  }
+  static const char* Get(const char* src, T (&val)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+      src = Codec<W, T>::Get(src, val[i]);
+    }
+    return src;
+  }
+};
+
+template <WireFormat W, typename T>
+struct Codec<W, T, std::enable_if_t<HasFields<T>::value>> {
+  static constexpr unsigned kSize = T::SerialFields::template SizeAs<W>();
+  static char* Put(char* dst, const T& val) {
+    return T::SerialFields::template PackAs<W>(val, dst);
+  }
+  static const char* Get(const char* src, T& val) {
+    return T::SerialFields::template UnpackAs<W>(val, src);
+  }
+};
+
+//////////////////////////////////////////
+// Field descriptors
+
+template <auto M>
+struct Field;
+
+template <typename C, typename T, T C::*M>
+struct Field<M> {
+  template <WireFormat W>
+  static constexpr unsigned SizeAs() {
+    return Codec<W, T>::kSize;
+  }
+  template <WireFormat W, typename Obj>
+  static char* Put(const Obj& obj, char* dst) {
+    return Codec<W, T>::Put(dst, obj.*M);
+  }
+  template <WireFormat W, typename Obj>
+  static const char* Get(Obj& obj, const char* src) {
+    return Codec<W, T>::Get(src, obj.*M);
+  }
+};
+
+template <auto M, int Bias>
+struct Biased;
+
+template <typename C, int C::*M, int Bias>
+struct Biased<M, Bias> {
+  template <WireFormat W>
+  static constexpr unsigned SizeAs() {
+    return 4;
+  }
+  template <WireFormat W, typename Obj>
+  static char* Put(const Obj& obj, char* dst) {
+    return PutWord(dst, (unsigned int)(obj.*M + Bias));
+  }
+  template <WireFormat W, typename Obj>
+  static const char* Get(Obj& obj, const char* src) {
+    unsigned int word;
+    src = GetWord(src, &word);
+    obj.*M = (int)word - Bias;
+    return src;
+  }
+};
+
+template <auto A, auto B>
+struct Zip;
+
+template <typename C, typename T, size_t N, T (C::*A)[N], T (C::*B)[N]>
+struct Zip<A, B> {
+  template <WireFormat W>
+  static constexpr unsigned SizeAs() {
+    return 2 * N * Codec<W, T>::kSize;
+  }
+  template <WireFormat W, typename Obj>
+  static char* Put(const Obj& obj, char* dst) {
+    for (size_t i = 0; i < N; ++i) {
+      dst = Codec<W, T>::Put(dst, (obj.*A)[i]);
+      dst = Codec<W, T>::Put(dst, (obj.*B)[i]);
+    }
+    return dst;
+  }
+  template <WireFormat W, typename Obj>
+  static const char* Get(Obj& obj, const char* src) {
+    for (size_t i = 0; i < N; ++i) {
+      src = Codec<W, T>::Get(src, (obj.*A)[i]);
+      src = Codec<W, T>::Get(src, (obj.*B)[i]);
+    }
+    return src;
+  }
+};
+
+//////////////////////////////////////////
+// Field lists
+
+template <typename... F>
+struct Fields {
+  template <WireFormat W>
+  static constexpr unsigned SizeAs() {
+    return (0 + ... + F::template SizeAs<W>());
+  }
+  template <WireFormat W, typename Obj>
+  static char* PackAs(const Obj& obj, char* dst) {
+    ((dst = F::template Put<W>(obj, dst)), ...);
+    return dst;
+  }
+  template <WireFormat W, typename Obj>
+  static const char* UnpackAs(Obj& obj, const char* src) {
+    ((src = F::template Get<W>(obj, src)), ...);
+    return src;
+  }
+};
+
+// Base's fields followed by F...
+template <typename Base, typename... F>
+struct ExtendList;
+template <typename... B, typename... F>
+struct ExtendList<Fields<B...>, F...> {
+  typedef Fields<B..., F...> type;
+};
+template <typename Base, typename... F>
+using Extend = typename ExtendList<Base, F...>::type;
+
+//////////////////////////////////////////
+// GetSerialSize, SerialPack and SerialUnpack in the current wire format
+
+template <typename L>
+unsigned Size() {
+  static_assert(L::template SizeAs<WIRE_FIXED_POINT>() > 0, "empty field list");
+  if (CSendable::GetWireFormat() == WIRE_FULL_PRECISION) {
+    return L::template SizeAs<WIRE_FULL_PRECISION>();
+  }
+  return L::template SizeAs<WIRE_FIXED_POINT>();
+}
+
+// Returns the bytes written, 0 if buflen is too small
+template <typename L, WireFormat W, typename Obj>
+unsigned PackAs(const Obj& obj, char* buf, unsigned buflen) {
+  constexpr unsigned size = L::template SizeAs<W>();
+  if (buf == NULL || buflen < size) {
+    return 0;
+  }
+  L::template PackAs<W>(obj, buf);
+  return size;
+}
+
+template <typename L, typename Obj>
+unsigned Pack(const Obj& obj, char* buf, unsigned buflen) {
+  if (CSendable::GetWireFormat() == WIRE_FULL_PRECISION) {
+    return PackAs<L, WIRE_FULL_PRECISION>(obj, buf, buflen);
+  }
+  return PackAs<L, WIRE_FIXED_POINT>(obj, buf, buflen);
+}
+
+// Returns the bytes read, 0 if buflen is too small
+template <typename L, WireFormat W, typename Obj>
+unsigned UnpackAs(Obj& obj, const char* buf, unsigned buflen) {
+  constexpr unsigned size = L::template SizeAs<W>();
+  if (buf == NULL || buflen < size) {
+    return 0;
+  }
+  L::template UnpackAs<W>(obj, buf);
+  return size;
+}
+
+template <typename L, typename Obj>
+unsigned Unpack(Obj& obj, const char* buf, unsigned buflen) {
+  if (CSendable::GetWireFormat() == WIRE_FULL_PRECISION) {
+    return UnpackAs<L, WIRE_FULL_PRECISION>(obj, buf, buflen);
+  }
+  return UnpackAs<L, WIRE_FIXED_POINT>(obj, buf, buflen);
+}
+
+}  // namespace serial
+
+#endif  // _SERIAL_FIELDS_H_MM4
@@ -9,9 +9,36 @@
 
 #include "stdafx.h"
 
+#include <string>
+#include <vector>
+
 class CWorld;
 class CTeam;
 class CServerNet;
+class SnapshotEncoder;
+class ObserverStream;
+class MatchRecorder;
+
+// A team's think times over the game, the time from being sent the world
+// to its orders arriving, in buckets that double from 1 us
+class ThinkHistogram {
+ public:
+  static const unsigned int kBuckets = 32;  // The last holds >= 2^30 us
+
+  ThinkHistogram();
+  void Add(double seconds);
+
+  unsigned int GetCount() const { return count; }
+  double GetMean() const { return count ? total / count : 0.0; }
+  double GetLongest() const { return longest; }
+  // Upper edge of the bucket holding fraction p of the times, in seconds
+  double GetPercentile(double p) const;
+
+ private:
+  unsigned int buckets[kBuckets];
+  unsigned int count;
+  double total, longest;
+};
 
 class CServer {
  public:
@@ -25,13 +52,21 @@ class CServer {
   unsigned int ConnectClients();  // Return # successfully connected
 
   void IntroduceWorld(int conn);
-  unsigned int SendWorld(int conn);
+  std::vector<char> WorldIntro();  // Team and ship counts IntroduceWorld sends
+  unsigned int SendWorld(int conn);  // Packs the world and sends it to conn
   void BroadcastWorld();  // Sends world to all open connections
   void SendWorldToObserver();  // Sends latest world snapshot to observer
   void MeetTeams();       // Gets teams from clients and sends to observer
 
+  // Records the match to a log mm4replay can play back. seed is the one the
+  // world was built with and args the server's command line, so the game
+  // can be played again from the log. Call before MeetTeams.
+  bool RecordTo(const char *path, unsigned int seed,
+                const std::vector<std::string> &args);
+
   void ReceiveTeamOrders();  // Gives orders to local teams' ships
-  void WaitForObserver();    // Waits for observer to send ack
+  void PrintThinkTimes() const;  // Each team's think-time percentiles
+  void WaitForObserver();    // Waits for observer to ack (or catch up)
 
   double Simulation();  // return game time
 
@@ -46,13 +81,54 @@ class CServer {
 
   unsigned int ObsConn;  // Observer connection
   bool *abOpen;  // Flag to tell if connection's open
+  unsigned int nConns;  // Size of abOpen
+
+  // Relay mode: spectators may connect at any time; those that came
+  // before the game started wait here for the stream
+  bool bRelay;
+  std::vector<unsigned int> auSpecConns;
+  std::vector<std::vector<char>> aObsHello;  // World intro, team init data
 
   unsigned int wldbuflen;
   char *wldbuf;  // World buffer
+  unsigned int wldimglen;  // Length of the image last packed into wldbuf
+
+  // Frame to send for the image in wldbuf: wldbuf itself (keyframe) or a
+  // delta from one of the encoders
+  const char *wldframe;
+  unsigned int wldframelen;
+
+  // Delta stream for the team broadcast
+  SnapshotEncoder *pTeamSnap;
+
+  // Carries worlds to the observer and spectators once MeetTeams is done,
+  // so the game doesn't wait on them; NULL before then, or when there's
+  // neither an observer nor relay mode
+  ObserverStream *pObsStream;
+
+  void StartObserverStream();  // Hands the viewers' connections to the stream
+  void ServiceObserver();      // Picks up pause/resume and disconnects
+  void IdleWhilePaused();      // Keeps the observer fed while paused
+
+  // Packs the world once for the observer stream and the match log
+  void ShowWorld(unsigned int step);
+
+  // Match log; NULL unless recording
+  MatchRecorder *pRecorder;
+  unsigned int uRecordSeed;
+  std::vector<std::string> asRecordArgs;
+
+  // Serialize the world into wldbuf once and encode it for one stream;
+  // every connection of that stream is then sent the same frame.
+  // Returns 0 on error.
+  unsigned int PackWorldImage(SnapshotEncoder *pSnap);
+  unsigned int SendWorldImage(int conn);
+  void SendWorldToTeams();  // The packed frame, to every open team
 
   CServerNet *pmyNet;
   CWorld *pmyWorld;
   CTeam **aTms;
+  std::vector<ThinkHistogram> aThinkTimes;  // By team
 
   bool bPaused = false;
 };
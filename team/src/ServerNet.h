@@ -19,12 +19,20 @@ class CServerNet : public CNetwork {
  private:
   int port;
   int main_socket;
+  int local_socket;  // Unix socket for teams on this host, or -1
   struct sockaddr_in serv_addr;
 
  public:
   CServerNet(int themaxconn, int port, int maxqueuelen = 2048);
+  ~CServerNet();
 
+  // Accepts the next client on either socket. One on the unix socket is
+  // offered a shared-memory link at once.
   int WaitForConn(void);
+
+  // Hands the listening socket to the caller and closes the unix one;
+  // WaitForConn fails afterwards
+  int ReleaseListenSocket(void);
 };
 
 #endif
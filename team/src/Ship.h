@@ -12,6 +12,7 @@
 #include "Asteroid.h"
 #include "GameConstants.h"
 #include "Thing.h"
+#include "Vec2.h"
 
 class CTeam;
 class CBrain;
@@ -81,6 +82,7 @@ class CShip : public CThing {
   unsigned GetSerialSize() const;
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
+  void CopyState(const CThing& OthThing);
 
  protected:
   unsigned int myNum;
@@ -95,6 +97,17 @@ class CShip : public CThing {
   double adStatCur[(unsigned int)S_ALL_STATS];
   double adStatMax[(unsigned int)S_ALL_STATS];
 
+  // Wire layout. The docked station's team index goes out +1, so 0 means
+  // not docked at one.
+  typedef serial::Extend<
+      CThing::SerialFields, serial::Field<&CShip::myNum>,
+      serial::Field<&CShip::bDockFlag>, serial::Field<&CShip::dDockDist>,
+      serial::Field<&CShip::dLaserDist>,
+      serial::Biased<&CShip::dockedStationTeamIndex_, 1>,
+      serial::Field<&CShip::adOrders>,
+      serial::Zip<&CShip::adStatCur, &CShip::adStatMax>>
+      SerialFields;
+
   virtual void HandleCollision(CThing* pOthThing, CWorld* pWorld = NULL);
   virtual void HandleJettison();
 
@@ -121,9 +134,9 @@ class CShip : public CThing {
     double thrust_cost;
     double governor_cost; // 0.0 if thrust was not governed
     double total_cost; // thrust_cost + governor_cost
-    CTraj dv_achieved; // .rho is the magnitude of the achieved thurst, .theta is the heading
+    CVec2 dv_achieved; // Achieved delta-v, Cartesian
   };
-  ThrustCost CalcThrustCost(double thrustamt, CTraj v, double orient, double mass, double fuel_avail, bool is_docked, bool launched_this_turn) const;
+  ThrustCost CalcThrustCost(double thrustamt, const CVec2& v, double orient, double mass, double fuel_avail, bool is_docked, bool launched_this_turn) const;
 
   // Drift helpers
   void ProcessShieldOrder(double shieldamt);
@@ -0,0 +1,66 @@
+//
+// ShmRing
+//
+// Shared-memory frame ring for peers on the same host
+//
+// A ring is a memfd written by one process, its producer, and mapped
+// read-only by every peer it is handed to. The producer copies a frame in
+// once and tells each peer where it went; the peers read it in place. Each
+// ring's header also carries one slot per peer in which the producer
+// reports how far it has read that peer's ring, so a producer never
+// overwrites a frame a peer may still be reading.
+//
+// Positions are absolute byte counts since the ring was created; a frame
+// at pos starts at pos % capacity and never wraps (the producer skips to
+// the start of the data area instead).
+
+#ifndef __ShmRing__
+#define __ShmRing__
+
+#include <stddef.h>
+#include <stdint.h>
+
+class ShmRing {
+ public:
+  static const unsigned int kMaxSlots = 64;  // Peers per ring
+
+  ShmRing();
+  ~ShmRing();
+
+  // Producer: creates a ring with capacity bytes of frame data
+  bool Create(size_t capacity);
+
+  // Returns a new read-only descriptor for the ring, for handing to a peer
+  // (the caller closes it), or -1
+  int ShareFd() const;
+
+  // Copies len bytes in at the next free position without going past
+  // oldest, the earliest position some peer may still read. Returns false
+  // if there's no room.
+  bool Write(const char *data, unsigned int len, uint64_t oldest,
+             uint64_t *pos);
+  uint64_t GetHead() const { return head; }
+
+  // Reader: maps a ring a peer shared. Takes ownership of fd.
+  bool Attach(int fd);
+
+  // The frame of len bytes at pos, or NULL if that isn't inside the ring
+  const char *Frame(uint64_t pos, unsigned int len) const;
+
+  // Progress reports. Only the producer sets them, in its own ring.
+  void SetReadPos(unsigned int slot, uint64_t pos);
+  uint64_t GetReadPos(unsigned int slot) const;
+
+ private:
+  struct Header;
+
+  int fd;
+  char *map;
+  size_t maplen;
+  Header *hdr;
+  char *data;
+  size_t capacity;
+  uint64_t head;  // Producer: where the next frame goes
+};
+
+#endif
@@ -33,10 +33,14 @@ class CStation : public CThing {
   unsigned GetSerialSize() const;
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
+  void CopyState(const CThing& OthThing);
 
  protected:
   double dCargo;
 
+  typedef serial::Extend<CThing::SerialFields, serial::Field<&CStation::dCargo>>
+      SerialFields;  // Wire layout
+
   virtual void HandleCollision(CThing* pOthThing, CWorld* pWorld = NULL);
 
  private:
@@ -0,0 +1,23 @@
+/* TeamPlugin.h
+ * Shared-library entry point for MechMania IV teams
+ *
+ * A team built as a plugin (see mm4_add_team_plugin in CMakeLists.txt)
+ * exports an extern "C" factory wrapping its CTeam::CreateTeam(). mm4batch
+ * dlopen()s several plugins into one process, which a normal link cannot do
+ * because every team defines the same CTeam::CreateTeam symbol.
+ *
+ * Engine code (CWorld, CShip, g_pParser, ...) is not linked into plugins; it
+ * is resolved against the host executable, so all teams share one engine and
+ * one set of game constants.
+ */
+
+#ifndef _TEAM_PLUGIN_H_MM4
+#define _TEAM_PLUGIN_H_MM4
+
+class CTeam;
+
+#define MM4_TEAM_PLUGIN_FACTORY "MM4CreateTeam"
+
+extern "C" CTeam* MM4CreateTeam(void);
+
+#endif  // _TEAM_PLUGIN_H_MM4
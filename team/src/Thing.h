@@ -13,6 +13,7 @@
 #include "Coord.h"
 #include "GameConstants.h"
 #include "Sendable.h"
+#include "SerialFields.h"
 #include "Traj.h"
 #include "stdafx.h"
 
@@ -57,11 +58,8 @@ class CThing : public CSendable {
       mass = dm;
   }
   void SetOrient(double ort = 0.0) { orient = ort; }
-  void SetSize(double sz = g_thing_minsize) {
-    if (sz >= g_thing_minsize)
-      size = sz;
-  }
-  void SetPos(CCoord& CPnew) { Pos = CPnew; }
+  void SetSize(double sz = g_thing_minsize);
+  void SetPos(CCoord& CPnew);
   void SetVel(CTraj& CTnew) { Vel = CTnew; }
   void SetTeam(CTeam* pnewTeam) { pmyTeam = pnewTeam; }
 
@@ -102,6 +100,11 @@ class CThing : public CSendable {
   virtual unsigned SerialPack(char* buf, unsigned buflen) const;
   virtual unsigned SerialUnpack(char* buf, unsigned buflen);
 
+  // Full-precision copy of OthThing's state, for CWorld::CopyFrom. Team,
+  // world and world index stay as they are; pointers to other things are
+  // looked up again in this thing's world by world index.
+  virtual void CopyState(const CThing& OthThing);
+
   double bIsColliding, bIsGettingShot;  // Angle of damage origin
 
  protected:
@@ -121,6 +124,9 @@ class CThing : public CSendable {
 
   virtual void HandleCollision(CThing* pOthThing, CWorld* pWorld = NULL);
 
+  // Batched CThing::Drift for asteroids and stations (CWorld::PhysicsModel)
+  friend class KinematicsStore;
+
  private:
   unsigned int ulIDCookie;
 
@@ -137,6 +143,18 @@ class CThing : public CSendable {
   // Facing detection implementations (Private)
   bool IsFacingOld(const CThing& OthThing) const;  // Legacy
   bool IsFacingNew(const CThing& OthThing) const;  // Toroidal shortest-path aware
+
+ protected:
+  // Wire layout, in SerialPack order; derived classes extend it
+  typedef serial::Fields<
+      serial::Field<&CThing::TKind>, serial::Field<&CThing::ulIDCookie>,
+      serial::Field<&CThing::uImgSet>, serial::Field<&CThing::orient>,
+      serial::Field<&CThing::omega>, serial::Field<&CThing::mass>,
+      serial::Field<&CThing::size>, serial::Field<&CThing::DeadFlag>,
+      serial::Field<&CThing::bIsColliding>,
+      serial::Field<&CThing::bIsGettingShot>, serial::Field<&CThing::Name>,
+      serial::Field<&CThing::Pos>, serial::Field<&CThing::Vel>>
+      SerialFields;
 };
 
 #endif  // !_THING_H_SFEFLKJEFLJESNF
@@ -0,0 +1,164 @@
+/* ThingPool.h
+ * Slab pool for the things a CWorld creates and destroys
+ * For use with MechMania IV
+ *
+ * Lasers and collisions shatter asteroids into fragments every sub-tick,
+ * KillDeadThings() frees the pieces that die, and every client's
+ * SerialUnpack() rebuilds whatever its slots lost. A pool keeps those
+ * objects in slabs of kSlabSlots and hands freed slots back out, so once
+ * a game has reached its largest population no more memory is allocated.
+ *
+ *   New()      constructs a T in a free slot (a new slab if none is free)
+ *   Delete()   destroys it and puts its slot on the free list
+ *   Release()  Delete() if the object is one of the pool's, else false
+ *
+ * Finding an object's slot is a binary search of the slab addresses, so
+ * freeing stays cheap in a world that has grown hundreds of slabs.
+ *
+ * Slots are reused most recently freed first, so a stale pointer soon
+ * points at a different live object; hold a CWorld ThingHandle instead.
+ * Without NDEBUG a deleted slot is filled with kPoison, and deleting a
+ * slot twice, or something the pool doesn't own, fails an assert.
+ */
+
+#ifndef _THING_POOL_H_MM4
+#define _THING_POOL_H_MM4
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <class T>
+class ThingPool {
+ public:
+  static const unsigned int kSlabSlots = 64;
+  static const unsigned char kPoison = 0xdd;
+
+  ThingPool() : free_((unsigned int)-1), live_(0) {}
+  ~ThingPool() {
+    // Objects still out (e.g. dropped by a full AddThingToWorld queue)
+    // die with the pool
+    for (size_t s = 0; s < slabs_.size(); ++s) {
+      for (unsigned int i = 0; i < kSlabSlots; ++i) {
+        if (slabs_[s][i].nextfree == kLive) {
+          slabs_[s][i].Object()->~T();
+        }
+      }
+      delete[] slabs_[s];
+    }
+  }
+
+  ThingPool(const ThingPool&) = delete;
+  ThingPool& operator=(const ThingPool&) = delete;
+
+  template <typename... Args>
+  T* New(Args&&... args) {
+    if (free_ == (unsigned int)-1) {
+      Grow();
+    }
+    unsigned int slot = free_;
+    Slot& s = At(slot);
+    T* obj = new (s.storage) T(std::forward<Args>(args)...);
+    free_ = s.nextfree;
+    s.nextfree = kLive;
+    ++live_;
+    return obj;
+  }
+
+  void Delete(T* obj) {
+    unsigned int slot = SlotOf(obj);
+    assert(slot != (unsigned int)-1 && "ThingPool: not one of ours");
+    DeleteSlot(slot, obj);
+  }
+
+  bool Release(T* obj) {
+    unsigned int slot = SlotOf(obj);
+    if (slot == (unsigned int)-1) {
+      return false;
+    }
+    DeleteSlot(slot, obj);
+    return true;
+  }
+
+  bool Owns(const void* ptr) const { return SlotOf(ptr) != (unsigned int)-1; }
+
+  // True if ptr is an object of this pool that hasn't been deleted
+  bool IsLive(const void* ptr) const {
+    unsigned int slot = SlotOf(ptr);
+    return slot != (unsigned int)-1 && At(slot).nextfree == kLive;
+  }
+
+  unsigned int GetLiveCount() const { return live_; }
+  unsigned int GetCapacity() const { return (unsigned int)slabs_.size() * kSlabSlots; }
+
+ private:
+  static const unsigned int kLive = (unsigned int)-2;  // nextfree of a slot in use
+
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    unsigned int nextfree;  // Next free slot, or kLive
+
+    T* Object() { return reinterpret_cast<T*>(storage); }
+  };
+
+  // A slab's address and its number in slabs_
+  struct SlabAt {
+    uintptr_t addr;
+    unsigned int slab;
+
+    bool operator<(uintptr_t p) const { return addr < p; }
+  };
+
+  Slot& At(unsigned int slot) const { return slabs_[slot / kSlabSlots][slot % kSlabSlots]; }
+
+  void DeleteSlot(unsigned int slot, T* obj) {
+    Slot& s = At(slot);
+    assert(s.nextfree == kLive && "ThingPool: deleted twice");
+    obj->~T();
+#ifndef NDEBUG
+    memset(s.storage, kPoison, sizeof(s.storage));
+#endif
+    s.nextfree = free_;
+    free_ = slot;
+    --live_;
+  }
+
+  unsigned int SlotOf(const void* ptr) const {
+    uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+    // The last slab starting at or before p
+    typename std::vector<SlabAt>::const_iterator at =
+        std::lower_bound(bases_.begin(), bases_.end(), p + 1);
+    if (at == bases_.begin()) {
+      return (unsigned int)-1;
+    }
+    --at;
+    size_t off = p - at->addr;
+    if (off >= kSlabSlots * sizeof(Slot) || off % sizeof(Slot) != 0) {
+      return (unsigned int)-1;  // Past the slab, or not the start of an object
+    }
+    return (unsigned int)(at->slab * kSlabSlots + off / sizeof(Slot));
+  }
+
+  void Grow() {
+    Slot* slab = new Slot[kSlabSlots];
+    unsigned int base = (unsigned int)slabs_.size() * kSlabSlots;
+    for (unsigned int i = kSlabSlots; i-- > 0;) {
+      slab[i].nextfree = free_;
+      free_ = base + i;
+    }
+    SlabAt entry = {reinterpret_cast<uintptr_t>(slab), (unsigned int)slabs_.size()};
+    bases_.insert(std::lower_bound(bases_.begin(), bases_.end(), entry.addr), entry);
+    slabs_.push_back(slab);
+  }
+
+  std::vector<Slot*> slabs_;
+  std::vector<SlabAt> bases_;  // By address
+  unsigned int free_;  // First free slot, or -1
+  unsigned int live_;
+};
+
+#endif  // _THING_POOL_H_MM4
@@ -10,6 +10,7 @@
 #define _TRAJ_H_ESFJHFLKJWEJKLFH
 
 #include "Sendable.h"
+#include "SerialFields.h"
 #include "stdafx.h"
 
 class CCoord;
@@ -61,6 +62,9 @@ class CTraj : public CSendable {
   unsigned GetSerialSize() const;
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
+
+  typedef serial::Fields<serial::Field<&CTraj::rho>, serial::Field<&CTraj::theta>>
+      SerialFields;  // Wire layout
 };
 
 #endif  // ! _TRAJ_H_ESFJHFLKJWEJKLFH
@@ -0,0 +1,88 @@
+/* Vec2.h
+ * Declaration of struct CVec2
+ * Cartesian 2D vector for engine-side velocity math
+ * For use with MechMania IV
+ *
+ * CTraj keeps velocities in polar form (rho, theta), so every CTraj sum or
+ * difference goes through cos/sin on both operands and hypot/atan2 on the
+ * result. Engine code that chains several vector operations converts to
+ * CVec2 once, does the arithmetic in Cartesian form, and converts back with
+ * ToTraj() only where a CTraj is stored or handed to team code.
+ *
+ * Unlike CCoord, a CVec2 is a free vector: it is never wrapped to the
+ * toroidal world bounds. Everything is inline and no virtual functions are
+ * involved, so temporaries cost nothing beyond their two doubles.
+ */
+
+#ifndef _VEC2_H_MM4
+#define _VEC2_H_MM4
+
+#include <cmath>
+
+#include "Coord.h"
+#include "Traj.h"
+
+struct CVec2 {
+  double fX, fY;
+
+  CVec2() : fX(0.0), fY(0.0) {}
+  CVec2(double x, double y) : fX(x), fY(y) {}
+
+  // Same components as CTraj::ConvertToCoord()
+  explicit CVec2(const CTraj& traj)
+      : fX(cos(traj.theta) * traj.rho), fY(sin(traj.theta) * traj.rho) {}
+  explicit CVec2(const CCoord& crd) : fX(crd.fX), fY(crd.fY) {}
+
+  static CVec2 FromPolar(double rho, double theta) {
+    return CVec2(cos(theta) * rho, sin(theta) * rho);
+  }
+
+  // Polar form, normalized like every CTraj (theta = 0 for the zero vector)
+  CTraj ToTraj() const {
+    CTraj res;
+    res.rho = hypot(fX, fY);
+    res.theta = (res.rho == 0.0) ? 0.0 : atan2(fY, fX);
+    return res;
+  }
+  CCoord ToCoord() const { return CCoord(fX, fY); }
+
+  double LengthSq() const { return fX * fX + fY * fY; }
+  double Length() const { return hypot(fX, fY); }
+  double Dot(const CVec2& oth) const { return fX * oth.fX + fY * oth.fY; }
+  double Cross(const CVec2& oth) const { return fX * oth.fY - fY * oth.fX; }
+
+  CVec2& operator+=(const CVec2& oth) {
+    fX += oth.fX;
+    fY += oth.fY;
+    return *this;
+  }
+  CVec2& operator-=(const CVec2& oth) {
+    fX -= oth.fX;
+    fY -= oth.fY;
+    return *this;
+  }
+  CVec2& operator*=(double scale) {
+    fX *= scale;
+    fY *= scale;
+    return *this;
+  }
+  CVec2 operator-() const { return CVec2(-fX, -fY); }
+};
+
+inline CVec2 operator+(const CVec2& v1, const CVec2& v2) {
+  return CVec2(v1.fX + v2.fX, v1.fY + v2.fY);
+}
+inline CVec2 operator-(const CVec2& v1, const CVec2& v2) {
+  return CVec2(v1.fX - v2.fX, v1.fY - v2.fY);
+}
+inline CVec2 operator*(const CVec2& v, double scale) {
+  return CVec2(v.fX * scale, v.fY * scale);
+}
+inline CVec2 operator*(double scale, const CVec2& v) {
+  return CVec2(v.fX * scale, v.fY * scale);
+}
+inline CVec2 operator/(const CVec2& v, double scale) {
+  return CVec2(v.fX / scale, v.fY / scale);
+}
+
+#endif  // _VEC2_H_MM4
@@ -24,18 +24,38 @@
 #include <utility>
 #include <vector>
 
+#include "CollisionGrid.h"
+#include "CollisionStateTable.h"
 #include "CollisionTypes.h"
 #include "Asteroid.h"
+#include "KinematicsStore.h"
+#include "LaserTargetIndex.h"
 #include "MessageResult.h"
 #include "Sendable.h"
 #include "Thing.h"
+#include "ThingPool.h"
 #include "stdafx.h"
 #include "audio/AudioTypes.h"
 
-#define MAX_THINGS 512
+// World slots. New things go on the end of the list until it is
+// INIT_THINGS long, then into the lowest vacated slot if there is one. The
+// slot tables start INIT_THINGS long and double when the list reaches
+// their end, up to MAX_THINGS.
+#define INIT_THINGS 512
+#define MAX_THINGS (1 << 20)
 
 const unsigned int BAD_INDEX = ((unsigned int)-1);
 
+// Names a world slot and which of its occupants is meant. The slot's
+// generation changes whenever its thing leaves the world, so a handle kept
+// past that resolves to NULL rather than to whatever took the slot next.
+struct ThingHandle {
+  unsigned int slot = BAD_INDEX;
+  unsigned int generation = 0;
+
+  bool IsNull() const { return slot == BAD_INDEX; }
+};
+
 class CTeam;
 
 struct CollisionPair {
@@ -48,7 +68,18 @@ class CWorld : public CSendable {
  public:
   CWorld(unsigned int nTm);
   ~CWorld();
-  CWorld* CreateCopy();
+  CWorld* CreateCopy();  // Same as Clone()
+
+  // Lookahead copies. Clone() makes a full-precision deep copy that owns
+  // stand-in teams (same numbers, names and ships, no AI or brains), so it
+  // can be stepped with PhysicsModel()/LaserModel() without touching this
+  // world. CopyFrom() overwrites such a copy with src's current state,
+  // reusing its objects; once warmed up it does not allocate unless src
+  // holds things the copy has lost. It returns false, doing nothing, if
+  // this world was not made by Clone() or src has a different team count.
+  // Things still queued by AddThingToWorld() are not copied.
+  CWorld* Clone() const;
+  bool CopyFrom(const CWorld& src);
 
   CTeam* GetTeam(unsigned int nt) const;  // Returns ptr to team, NULL on error
   unsigned int GetNumTeams() const;       // Tells how many teams
@@ -80,25 +111,41 @@ class CWorld : public CSendable {
   void LaserModelOld();                // Legacy laser processing (direct Collide() calls)
   void LaserModelNew();                // Deterministic laser processing (snapshot/command pipeline)
   void AddThingToWorld(CThing* pNewThing);
+
+  // Nearest thing shooter is facing (see CShip::LaserTarget); *dist gets
+  // its distance, or -1.0 if there is none. Answered from an index of the
+  // world that is rebuilt on first use after InvalidateLaserTargets().
+  CThing* FindLaserTarget(const CThing& shooter, double* dist);
+  void InvalidateLaserTargets() { laser_targets_.Invalidate(); }
   void ResolvePendingOperations(bool resetTransientState = true);
 
   void CreateAsteroids(AsteroidKind mat, unsigned int numast, double mass);
+
+  // Asteroids live in a pool this world owns (see ThingPool.h). Every
+  // asteroid that will be added to this world should come from
+  // NewAsteroid(), and every thing it removes goes to DeleteThing(), which
+  // deletes the ones that aren't from the pool.
+  CAsteroid* NewAsteroid(double mass = 40.0, AsteroidKind mat = GENAST);
+  void DeleteThing(CThing* pTh);
+
+  // Handles to things in the world (null for one that isn't); a stale one
+  // resolves to NULL
+  ThingHandle GetHandle(const CThing* pTh) const;
+  CThing* Resolve(ThingHandle h) const;
   CTeam* SetTeam(unsigned int n,
                  CTeam* pTm);  // Returns previous team ptr, NULL on fail
 
-  void ApplyCommandToSnapshot(const CollisionCommand& cmd,
-                              std::map<CThing*, CollisionState>& states);
-  void CollectCollisionSnapshots(std::map<CThing*, CollisionState>& snapshots,
-                                 std::map<CThing*, CollisionState>& current_states) const;
-  void CollectTeamObjects(CThing** team_objects, unsigned int& num_team_objects) const;
+  void ApplyCommandToSnapshot(const CollisionCommand& cmd, CollisionStateTable& states);
+  void CollectCollisionSnapshots(CollisionStateTable& snapshots,
+                                 CollisionStateTable& current_states) const;
+  void CollectTeamObjects(std::vector<CThing*>& team_objects) const;
   std::vector<CollisionPair> DetectCollisionPairs(
-      const std::map<CThing*, CollisionState>& snapshots,
-      CThing** team_objects,
-      unsigned int num_team_objects);
+      const CollisionStateTable& snapshots,
+      const std::vector<CThing*>& team_objects);
   void SortAndShuffleCollisions(std::vector<CollisionPair>& collisions);
   void GenerateCollisionOutputs(
       const std::vector<CollisionPair>& collisions,
-      std::map<CThing*, CollisionState>& current_states,
+      CollisionStateTable& current_states,
       std::vector<CollisionCommand>& all_commands,
       std::vector<SpawnRequest>& all_spawns,
       bool use_new_physics,
@@ -113,7 +160,15 @@ class CWorld : public CSendable {
                              bool use_docking_fix,
                              bool preserve_nonfrag_asteroids);
 
+  // Things in the world, packed and in world index order: all of them, or
+  // those of one kind. Adding or killing things (AddNewThings(),
+  // KillDeadThings()) invalidates iterators into them, as it does for a
+  // std::vector.
+  const std::vector<CThing*>& GetLiveThings() const { return live_things_; }
+  const std::vector<CThing*>& GetLiveThings(ThingKind kind) const { return live_kind_[kind]; }
+
   CThing* GetThing(unsigned int index) const;      // returns NULL on failure
+  unsigned int GetCapacity() const { return (unsigned int)apThings.size(); }  // Slots so far
   unsigned int GetNextIndex(unsigned int curindex) const;  // returns (unsigned int)-1 if at end of list
   unsigned int GetPrevIndex(
       unsigned int curindex) const;  // returns (unsigned int)-1 if at beginning of list
@@ -121,12 +176,13 @@ class CWorld : public CSendable {
 
   // Serialization routines
   unsigned GetSerialSize() const;
+  unsigned GetSerialTeamSize() const;  // Team block after the image header
   unsigned SerialPack(char* buf, unsigned buflen) const;
   unsigned SerialUnpack(char* buf, unsigned buflen);
   CThing* CreateNewThing(ThingKind TKind, unsigned int iTm);
 
   // For internal use only
-  double GetTimeStamp();  // Returns #sec, to 1msec res
+  double GetTimeStamp();  // Returns #sec on a monotonic clock
   double* atstamp;
   double* auClock;
 
@@ -140,27 +196,59 @@ class CWorld : public CSendable {
   void SeedCollisionRng(unsigned int seed) { collision_rng_.seed(seed); }
 
  protected:
-  CThing* apThings[MAX_THINGS];
-  unsigned int aUNextInd[MAX_THINGS];
-  unsigned int aUPrevInd[MAX_THINGS];
-
-  CThing* apTAddQueue[MAX_THINGS];
-  unsigned int numNewThings;
-
-  void RemoveIndex(unsigned int index);
+  // By world index; every per-slot table is GetCapacity() long
+  std::vector<CThing*> apThings;
+  std::vector<unsigned int> aUNextInd;
+  std::vector<unsigned int> aUPrevInd;
+  std::vector<unsigned int> slot_generation_;  // See ThingHandle
+  std::vector<unsigned int> free_slots_;       // Min-heap of vacated slots
+  std::vector<bool> slot_listed_;              // Slot is in free_slots_
+
+  // What GetLiveThings() returns, in index order. Kept alongside the index
+  // list: appended to or inserted into as things are added, packed as they
+  // are killed; ReLinkList() links the index list from it.
+  std::vector<CThing*> live_things_;
+  std::vector<CThing*> live_kind_[SHIP + 1];
+  std::vector<CThing*> dead_things_;      // KillDeadThings scratch
+  std::vector<CThing*> unpacked_things_;  // SerialUnpack scratch
+
+  std::vector<CThing*> apTAddQueue;
+  std::vector<CThing*> team_objects_;     // CollisionEvaluation scratch
+  std::vector<unsigned int> team_slot_;   // DetectCollisionPairs scratch
+
+  void Reserve(unsigned int slots);        // Grows every per-slot table
+  void ListFreeSlot(unsigned int index);   // Offers index to TakeFreeSlot
+  void ListFreeSlots();                    // Lists the holes among live_things_
+  unsigned int TakeFreeSlot();             // Lowest empty slot, or BAD_INDEX
+  void RemoveIndex(unsigned int index);  // Unlinks and unlists
+  void UnlinkIndex(unsigned int index);  // Only takes it off the index list
+  void ListLiveThing(CThing* pTh);       // Appends to the live lists
+  void InsertLiveThing(CThing* pTh);     // Lists and links a filled hole
   unsigned int AddNewThings();
   unsigned int KillDeadThings();
   unsigned int CollisionEvaluation();
   unsigned int CollisionEvaluationOld();  // Legacy collision processing
   unsigned int CollisionEvaluationNew();  // Snapshot/command collision pipeline
-  void ReLinkList();
+  void ReLinkList();  // Links the index list from live_things_
 
   double gametime;
   unsigned int numTeams;
   CTeam** apTeams;
   unsigned int currentTurn;  // Track current turn number for logging
+  bool owns_teams_;          // Made by Clone(): teams and all things are ours
+  std::vector<CThing*> spare_things_;  // Clone(): asteroids kept for reuse
+  ThingPool<CAsteroid> asteroid_pool_;
+  std::mt19937 clone_rng_;   // Absorbs constructor draws made while copying
   std::mt19937 collision_rng_;
   std::uniform_real_distribution<double> ship_collision_angle_dist_;
+  KinematicsStore kinematics_;    // Batched drift for non-ship things
+  CollisionGrid collision_grid_;  // Broadphase for DetectCollisionPairs
+  LaserTargetIndex laser_targets_;  // Ray queries for FindLaserTarget
+  // Per-tick collision state, reused across physics sub-ticks
+  CollisionStateTable collision_snapshots_;  // Tick-start snapshots (read-only)
+  CollisionStateTable collision_current_;    // Copy-on-write overlay of the above
+  CollisionStateTable laser_states_;         // Targets already hit by lasers this turn
+  CollisionMessageArena collision_messages_;  // Announcer text for the current pass
   std::vector<mm4::audio::EffectRequest> audioEvents_;
 };
 
@@ -0,0 +1,105 @@
+/* WorldSnapshot.h
+ * Keyframe + delta encoding of CWorld::SerialPack images
+ * For use with MechMania IV
+ *
+ * A full world image repeats the 2048-byte announcer text, every team's
+ * 512-byte message buffer and every thing's name, size, image set and ID
+ * cookie on every frame, although most of it is the same as last frame.
+ * The server runs one SnapshotEncoder per stream of frames (the team
+ * broadcast, the observer) and the client a SnapshotDecoder, which turn
+ * the image into one of two frame kinds:
+ *
+ *   keyframe  the SerialPack image itself, unchanged. A server that only
+ *             sends keyframes speaks exactly the old protocol.
+ *   delta     kDeltaMagic, then the image as differences from the previous
+ *             frame of the stream: the header and team block against the
+ *             old ones, and one record per thing, keyed by ulIDCookie and
+ *             diffed against that thing's record in the previous frame.
+ *
+ * Each diffed section is cut into 4-byte words and sent as dirty-word
+ * bitmasks (one top-level bit per group of 32 words, one mask per dirty
+ * group) followed by only the dirty words. A thing record only names its
+ * cookie when its base is not simply the record after the previous one's,
+ * so an unchanged thing costs one word. A section whose length changed, or
+ * a thing new since the last frame, goes out whole.
+ *
+ * The decoder rebuilds the exact image the encoder was given, and the
+ * client hands it to CWorld::SerialUnpack as before, so a client's world
+ * is the same whichever kind of frame carried it. Deltas name the hash of
+ * the image they apply to; a decoder that holds a different one drops them
+ * until the next keyframe, which the encoder sends every keyframe_interval
+ * frames, whenever a delta would not be smaller, and after ForceKeyframe().
+ */
+
+#ifndef _WORLD_SNAPSHOT_H_MM4
+#define _WORLD_SNAPSHOT_H_MM4
+
+#include <unordered_map>
+#include <vector>
+
+// First word of a delta frame. Never a valid UFirstIndex, which is where a
+// keyframe starts.
+const unsigned int kDeltaMagic = 0x4D344446;  // "M4DF"
+const unsigned int kDeltaVersion = 1;
+
+const unsigned int kDefaultKeyframeInterval = 100;
+
+class SnapshotEncoder {
+ public:
+  // keyframe_interval - frames between forced keyframes; 0 sends only
+  //                     keyframes
+  explicit SnapshotEncoder(
+      unsigned int keyframe_interval = kDefaultKeyframeInterval);
+
+  void SetKeyframeInterval(unsigned int keyframe_interval);
+  void ForceKeyframe();  // Next frame goes out as a keyframe
+
+  // Encodes image (teamlen bytes of team block after the fixed header)
+  // against the previous frame. Returns the frame to send and sets
+  // *framelen; that is image itself when the frame is a keyframe.
+  const char* Encode(const char* image, unsigned int len, unsigned int teamlen,
+                     unsigned int* framelen);
+
+  unsigned int GetKeyframeCount() const { return keyframes_; }
+  unsigned int GetDeltaCount() const { return deltas_; }
+
+ private:
+  // Fills out_ with image as a delta frame against base_
+  void EncodeDelta(const char* image, unsigned int len, unsigned int teamlen,
+                   unsigned int tailoff);
+
+  unsigned int interval_;
+  unsigned int since_keyframe_;
+  unsigned int keyframes_, deltas_;
+
+  // Previous frame's image and where its thing records are, by cookie
+  std::vector<char> base_;
+  unsigned int base_teamlen_, base_tailoff_;
+  unsigned int base_hash_;
+  std::unordered_map<unsigned int, unsigned int> base_records_;
+  std::unordered_map<unsigned int, unsigned int> records_;  // Current frame's
+
+  std::vector<char> out_;
+};
+
+class SnapshotDecoder {
+ public:
+  // maxlen - largest image a frame may rebuild
+  explicit SnapshotDecoder(unsigned int maxlen);
+
+  // Returns the rebuilt image (valid until the next call) and sets *len,
+  // or returns NULL for a malformed delta or one that does not apply to the
+  // image this decoder holds.
+  char* Decode(const char* frame, unsigned int framelen, unsigned int* len);
+
+ private:
+  unsigned int maxlen_;
+  bool have_base_;
+  std::vector<char> base_;
+  unsigned int base_hash_;
+  std::unordered_map<unsigned int, unsigned int> base_records_;
+
+  std::vector<char> out_;
+};
+
+#endif  // _WORLD_SNAPSHOT_H_MM4
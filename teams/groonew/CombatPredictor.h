@@ -12,7 +12,7 @@
  *
  * TECHNIQUE:
  * ==========
- * Uses CWorld::CreateCopy() to create a deep copy of the entire game world, then:
+ * Uses CWorld::Clone() to create a full-precision deep copy of the entire game world, then:
  * 1. Apply planned orders to your ship in the copy
  * 2. Run PhysicsModel() to simulate 1 second forward
  * 3. Call LaserTarget() in that future state
@@ -29,8 +29,10 @@
  * ============
  * 1. NO ENEMY AI STATE: Enemy ships will continue their current velocity but won't
  *    execute new orders (their Brain pointers aren't copied)
- * 2. PERFORMANCE: Full world copy + physics simulation is expensive (~1-2ms)
- *    - Suitable for 1-2 predictions per turn, not per-ship per-frame
+ * 2. PERFORMANCE: Clone() allocates a fresh world (~20-35us); one turn of
+ *    physics on it costs ~40-100us. Planners doing many rollouts per turn
+ *    should keep one Clone() and refresh it with CWorld::CopyFrom() (~2-5us,
+ *    no allocation) instead of cloning each time.
  * 3. ASSUMES LINEAR ENEMY MOTION: Enemies predicted using current velocity only
  * 4. COLLISIONS: If collision occurs during simulation, results may be unexpected
  *
@@ -131,7 +133,7 @@ public:
         }
 
         // Step 1: Create deep copy of entire world
-        CWorld* future = original->CreateCopy();
+        CWorld* future = original->Clone();
         if (!future) {
             return NULL;
         }
@@ -228,7 +230,7 @@ public:
             return;
         }
 
-        CWorld* future = original->CreateCopy();
+        CWorld* future = original->Clone();
         if (!future) {
             return;
         }